@@ -0,0 +1,92 @@
+/** 
+ *  tubex-solve - Benchmarks
+ *  Tube copies of the solver: allocations vs. TubePool
+ * ----------------------------------------------------------------------------
+ *
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex.h"
+#include "tubex-solve.h"
+
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+// Copies made as by the CID of the solver: three branches of x,
+// contracted, then released once their hull has been computed
+
+double cid_copies(const TubeVector& x, int nb_iterations, TubePool *pool, int& nb_allocations)
+{
+  SolverChrono timer;
+  const int nb_branches = 3;
+  TubeVector* v_branches[nb_branches];
+
+  // Gate set at an existing time: sampling x would give branches
+  // of another slicing, never recycled by the pool
+  double t = x[0].slice(x[0].nb_slices() / 2)->domain().lb();
+
+  int nb_recycled = pool != NULL ? pool->nb_recycled() : 0;
+  for(int k = 0 ; k < nb_iterations ; k++)
+  {
+    for(int i = 0 ; i < nb_branches ; i++)
+    {
+      v_branches[i] = pool != NULL ? pool->copy(x) : new TubeVector(x);
+      v_branches[i]->set(IntervalVector(x.size(), Interval(-1.,1.)), t);
+    }
+
+    for(int i = 0 ; i < nb_branches ; i++)
+    {
+      if(pool != NULL)
+        pool->release(v_branches[i]);
+      else
+        delete v_branches[i];
+    }
+  }
+
+  double t_elapsed = timer.elapsed();
+  nb_allocations = nb_iterations * nb_branches
+                 - (pool != NULL ? pool->nb_recycled() - nb_recycled : 0);
+  return t_elapsed;
+}
+
+int main(int argc, char** argv)
+{
+  // Arguments: [number of iterations]
+  int nb_iterations = argc > 1 ? atoi(argv[1]) : 1000;
+  Tube::enable_syntheses(false);
+
+  // Tube allocations (each one allocating all the slices) and times,
+  // without and with the pool
+  printf("%8s %8s %10s %10s %12s %12s %8s\n",
+    "slices", "dim", "allocs", "pool allocs", "alloc (s)", "pool (s)", "speedup");
+
+  int v_nb_slices[] = { 100, 1000, 10000 };
+  for(int nb_slices : v_nb_slices)
+    for(int n = 1 ; n <= 2 ; n++)
+    {
+      Interval domain(0., 10.);
+      TubeVector x(domain, domain.diam() / nb_slices, IntervalVector(n, Interval(-10.,10.)));
+
+      TubePool pool;
+      int iterations = std::max(1, nb_iterations * 100 / nb_slices);
+      int nb_allocs, nb_pool_allocs;
+      double t_alloc = cid_copies(x, iterations, NULL, nb_allocs);
+      double t_pool = cid_copies(x, iterations, &pool, nb_pool_allocs);
+      // Otherwise, the pool column would measure its misses
+      if(pool.nb_recycled() == 0)
+      {
+        printf("no tube recycled by the pool\n");
+        return EXIT_FAILURE;
+      }
+
+      printf("%8d %8d %10d %10d %12.4f %12.4f %7.1fx\n",
+        nb_slices, n, nb_allocs, nb_pool_allocs, t_alloc, t_pool, t_alloc / t_pool);
+    }
+
+  return EXIT_SUCCESS;
+}
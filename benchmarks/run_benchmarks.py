@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# ==================================================================
+#  tubex-solve - benchmarks
+#
+#  Runs the bundled problems headless, reports wall time, node count
+#  and solution count as JSON, and compares them against a baseline
+#  (the JSON output of a previous run, given by --baseline).
+#  Each problem can also be solved with several bisection strategies,
+#  the one exploring the fewest nodes being reported.
+# ==================================================================
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+PROBLEMS = [
+  "01_picard",
+  "02_xmsin_fwd",
+  "03_xmsin_bwd",
+  "04_bvp",
+  "05_delay",
+  "06_bvp_delay",
+  "07_integro_diff",
+  "08_bvp_delay_2d",
+  "09_csdp",
+  "10_large_initvalue",
+]
+
+
+STRATEGIES = ["first_component", "normalized"]
+
+
+def run_problem(bin_dir, name, repetitions, timeout, strategy=None):
+  """Runs a problem several times, returns the median figures."""
+  exe = os.path.join(bin_dir, name, name)
+  if not os.path.isfile(exe):
+    return {"status": "missing"}
+
+  times, runs = [], []
+  status = "ok"
+  for _ in range(repetitions):
+    with tempfile.TemporaryDirectory() as tmp:
+      stats_path = os.path.join(tmp, "stats.json")
+      t0 = time.perf_counter()
+      try:
+        cmd = [exe, "0", stats_path] + ([strategy] if strategy else [])
+        p = subprocess.run(cmd, stdout=subprocess.DEVNULL,
+                           stderr=subprocess.DEVNULL, timeout=timeout)
+      except subprocess.TimeoutExpired:
+        return {"status": "timeout", "timeout": timeout}
+      times.append(time.perf_counter() - t0)
+      if p.returncode != 0:
+        status = "failed"
+      if os.path.isfile(stats_path):
+        with open(stats_path) as f:
+          try:
+            runs.append(json.load(f))
+          except ValueError: # truncated or invalid stats file
+            status = "failed"
+
+  result = {"status": status, "repetitions": repetitions,
+            "wall_time": statistics.median(times),
+            "wall_time_min": min(times)}
+  if runs: # the search is deterministic: figures of the first run
+    result["nb_nodes"] = runs[0]["nb_nodes"]
+    result["nb_solutions"] = runs[0]["nb_solutions"]
+    result["stats"] = runs[0]
+  return result
+
+
+def compare(results, baseline, threshold):
+  """Returns the list of regressions with respect to the baseline."""
+  regressions = []
+  for name, res in sorted(results.items()):
+    ref = baseline.get(name)
+    if ref is None or res.get("status") != "ok":
+      if ref is not None and ref.get("status") == "ok":
+        regressions.append("%s: status %s (was ok)" % (name, res.get("status")))
+      continue
+    for key in ("wall_time", "nb_nodes"):
+      if key in res and key in ref and ref[key] > 0 \
+          and res[key] > ref[key] * (1. + threshold):
+        regressions.append("%s: %s %.4g -> %.4g (+%.0f%%)"
+          % (name, key, ref[key], res[key], 100. * (res[key] / ref[key] - 1.)))
+    if "nb_solutions" in res and "nb_solutions" in ref \
+        and res["nb_solutions"] != ref["nb_solutions"]:
+      regressions.append("%s: nb_solutions %d -> %d"
+        % (name, ref["nb_solutions"], res["nb_solutions"]))
+  return regressions
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Benchmarks of the bundled problems")
+  parser.add_argument("--bin-dir", required=True,
+                      help="build directory of the problems")
+  parser.add_argument("-n", "--repetitions", type=int, default=3)
+  parser.add_argument("--timeout", type=float, default=600.,
+                      help="maximal duration of one run (s)")
+  parser.add_argument("--problems", nargs="*", default=PROBLEMS)
+  parser.add_argument("--output", help="JSON file for the results")
+  parser.add_argument("--baseline", help="JSON results of a previous run")
+  parser.add_argument("--threshold", type=float, default=0.1,
+                      help="relative increase reported as a regression")
+  parser.add_argument("--strategies", nargs="*", default=[],
+                      help="bisection strategies to compare (%s)" % ", ".join(STRATEGIES))
+  args = parser.parse_args()
+
+  results = {}
+  for name in args.problems:
+    print("%-20s" % name, end="", flush=True, file=sys.stderr)
+    results[name] = run_problem(args.bin_dir, name, args.repetitions, args.timeout)
+    res = results[name]
+    if "wall_time" in res:
+      print("%8.3fs  nodes: %-6s solutions: %s" % (res["wall_time"],
+            res.get("nb_nodes", "?"), res.get("nb_solutions", "?")), end="", file=sys.stderr)
+    print("  [%s]" % res["status"], file=sys.stderr)
+
+    if args.strategies:
+      res["strategies"] = {}
+      for strategy in args.strategies:
+        print("  %-18s" % strategy, end="", flush=True, file=sys.stderr)
+        r = run_problem(args.bin_dir, name, args.repetitions, args.timeout, strategy)
+        r.pop("stats", None)
+        res["strategies"][strategy] = r
+        if "wall_time" in r:
+          print("%8.3fs  nodes: %-6s" % (r["wall_time"], r.get("nb_nodes", "?")),
+                end="", file=sys.stderr)
+        print("  [%s]" % r["status"], file=sys.stderr)
+      solved = [(r["nb_nodes"], s) for s, r in res["strategies"].items()
+                if r["status"] == "ok" and "nb_nodes" in r]
+      if solved:
+        res["best_strategy"] = min(solved)[1]
+        print("  best strategy: " + res["best_strategy"], file=sys.stderr)
+
+  output = json.dumps(results, indent=2, sort_keys=True)
+  if args.output:
+    with open(args.output, "w") as f:
+      f.write(output + "\n")
+  else:
+    print(output)
+
+  # No reference results are shipped: the baseline is the output
+  # of a previous run (--output), on the same machine
+  if not args.baseline:
+    print("no baseline given (--baseline): nothing to compare against",
+          file=sys.stderr)
+    return 0
+  if not os.path.isfile(args.baseline):
+    print("baseline %s not found: nothing to compare against" % args.baseline,
+          file=sys.stderr)
+    return 0
+
+  with open(args.baseline) as f:
+    regressions = compare(results, json.load(f), args.threshold)
+  for r in regressions:
+    print("REGRESSION " + r, file=sys.stderr)
+  if not regressions:
+    print("no regression with respect to " + args.baseline, file=sys.stderr)
+  return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+  sys.exit(main())
@@ -18,22 +18,68 @@ using namespace std;
 using namespace ibex;
 using namespace tubex;
 
-void contract(TubeVector& x)
+class ProblemContractor : public SolverContractor
 {
-  tubex::Function f("x", "-sin(x)");
+  public:
 
-  CtcPicard ctc_picard;
-  ctc_picard.contract(f, x, FORWARD | BACKWARD);
+    ProblemContractor() : m_f("x", "-sin(x)"), m_fv(m_f)
+    {
+      m_ctc_deriv.set_fast_mode(true);
+    }
 
-  CtcDeriv ctc_deriv;
-  ctc_deriv.set_fast_mode(true);
-  ctc_deriv.contract(x, f.eval_vector(x), FORWARD | BACKWARD);
-}
+    SolverContractor* clone() const
+    {
+      return new ProblemContractor();
+    }
 
-int main()
+    void contract(TubeVector& x)
+    {
+      m_ctc_picard.contract(m_f, x, FORWARD | BACKWARD);
+      m_ctc_deriv.contract(x, m_fv.eval_vector(x), FORWARD | BACKWARD);
+    }
+
+    const Interval contract_window(TubeVector& x, const Interval& t_window)
+    {
+      if(t_window == x.domain())
+      {
+        contract(x);
+        return x.domain();
+      }
+
+      // Once the tube is bounded, only the derivative contractor is
+      // applied, on the slices of the window
+
+      const TubeVector& v = m_fv.eval_vector(x, t_window);
+
+      vector<pair<Slice*,const Slice*> > v_slices;
+      int k = x[0].time_to_index(t_window.lb());
+      const Slice *s_v = v[0].slice(k);
+      for(Slice *s = x[0].slice(k) ; s != NULL && s->domain().lb() < t_window.ub() ; s = s->next_slice(), s_v = s_v->next_slice())
+        v_slices.push_back(make_pair(s, s_v));
+
+      for(size_t i = 0 ; i < v_slices.size() ; i++)
+        m_ctc_deriv.contract(*v_slices[i].first, *v_slices[i].second, FORWARD);
+
+      for(size_t i = v_slices.size() ; i-- > 0 ; )
+        m_ctc_deriv.contract(*v_slices[i].first, *v_slices[i].second, BACKWARD);
+
+      return t_window; // slices of the window, and their gates
+    }
+
+  protected:
+
+    tubex::Function m_f;
+    BatchedFunction m_fv; // derivative tube built in one pass
+    CtcPicard m_ctc_picard;
+    CtcDeriv m_ctc_deriv;
+};
+
+int main(int argc, char** argv)
 {
   /* =========== PARAMETERS =========== */
 
+    // Arguments: [graphics (0: headless run)] [path of a JSON file for the solver stats] [bisection strategy]
+    bool graphics = argc < 2 || atoi(argv[1]) != 0;
     Tube::enable_syntheses(false);
     Vector epsilon(1, 0.051);
     Interval domain(0.,10.);
@@ -44,12 +90,18 @@ int main()
     
   /* =========== SOLVER =========== */
 
-    tubex::Solver solver(epsilon);
+    tubex::Solver solver(epsilon, graphics);
+    if(argc > 3) // first_component (default) or normalized
+      solver.set_bisection_strategy(BisectionStrategy::from_name(argv[3]));
     solver.set_refining_fxpt_ratio(0.9);
     solver.set_propa_fxpt_ratio(0.9);
     solver.set_cid_fxpt_ratio(0.9);
-    solver.figure()->add_trajectoryvector(&truth, "truth");
-    list<TubeVector> l_solutions = solver.solve(x, &contract);
+    if(graphics)
+      solver.figure()->add_trajectoryvector(&truth, "truth");
+    ProblemContractor ctc;
+    list<TubeVector> l_solutions = solver.solve(x, ctc);
+    if(argc > 2) // figures of the resolution, used by the benchmarks
+      solver.stats().save_json(argv[2]);
 
 
   // Checking if this example still works:
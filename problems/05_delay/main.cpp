@@ -51,29 +51,47 @@ class FncDelayCustom : public tubex::Fnc
     double m_delay = 0.;
 };
 
-void contract(TubeVector& x)
+class ProblemContractor : public SolverContractor
 {
-  double delay = 0.5;
-  FncDelayCustom f(delay);
+  public:
 
-  CtcPicard ctc_picard;
-  ctc_picard.contract(f, x, FORWARD | BACKWARD);
+    ProblemContractor() : m_delay(0.5), m_f(m_delay)
+    {
+      m_ctc_deriv.set_fast_mode(true);
+    }
+
+    SolverContractor* clone() const
+    {
+      return new ProblemContractor();
+    }
+
+    void contract(TubeVector& x)
+    {
+      m_ctc_picard.contract(m_f, x, FORWARD | BACKWARD);
+
+      // Computing the derivative v from a delay of x
+      TubeVector v(x, IntervalVector(x.size()));
+      m_ctc_delay.contract(m_delay, x, v);
+      v *= exp(m_delay);
+
+      m_ctc_deriv.contract(x, v, FORWARD | BACKWARD);
+    }
 
-  // Computing the derivative v from a delay of x
-  CtcDelay ctc_delay;
-  TubeVector v(x, IntervalVector(x.size()));
-  ctc_delay.contract(delay, x, v);
-  v *= exp(delay);
+  protected:
 
-  CtcDeriv ctc_deriv;
-  ctc_deriv.set_fast_mode(true);
-  ctc_deriv.contract(x, v, FORWARD | BACKWARD);
-}
+    double m_delay;
+    FncDelayCustom m_f;
+    CtcPicard m_ctc_picard;
+    CtcDelay m_ctc_delay;
+    CtcDeriv m_ctc_deriv;
+};
 
-int main()
+int main(int argc, char** argv)
 {
   /* =========== PARAMETERS =========== */
 
+    // Arguments: [graphics (0: headless run)] [path of a JSON file for the solver stats] [bisection strategy]
+    bool graphics = argc < 2 || atoi(argv[1]) != 0;
     Tube::enable_syntheses(false);
     int n = 1;
     Vector epsilon(n, 10.);
@@ -87,12 +105,18 @@ int main()
 
   /* =========== SOLVER =========== */
 
-    tubex::Solver solver(epsilon);
+    tubex::Solver solver(epsilon, graphics);
+    if(argc > 3) // first_component (default) or normalized
+      solver.set_bisection_strategy(BisectionStrategy::from_name(argv[3]));
     solver.set_refining_fxpt_ratio(1.);
     solver.set_propa_fxpt_ratio(1.);
     solver.set_cid_fxpt_ratio(0.);
-    solver.figure()->add_trajectoryvector(&truth, "truth");
-    list<TubeVector> l_solutions = solver.solve(x, &contract);
+    if(graphics)
+      solver.figure()->add_trajectoryvector(&truth, "truth");
+    ProblemContractor ctc;
+    list<TubeVector> l_solutions = solver.solve(x, ctc);
+    if(argc > 2) // figures of the resolution, used by the benchmarks
+      solver.stats().save_json(argv[2]);
 
 
   // Checking if this example still works:
@@ -43,41 +43,68 @@ class FncIntegroDiff : public tubex::Fnc
     }
 };
 
-void contract(TubeVector& x)
+class ProblemContractor : public SolverContractor
 {
-  // Boundary constraints
-
-    Variable vx0, vx1;
-    SystemFactory fac;
-    fac.add_var(vx0);
-    fac.add_var(vx1);
-    fac.add_ctr(sqr(vx0) + sqr(vx1) = 1);
-    System sys(fac);
-    ibex::CtcHC4 hc4(sys);
-    IntervalVector bounds(2);
-    bounds[0] = x[0](0.);
-    bounds[1] = x[0](1.);
-    hc4.contract(bounds);
-    x.set(IntervalVector(1, bounds[0]), 0.);
-    x.set(IntervalVector(1, bounds[1]), 1.);
-
-  // Differential equation
-
-    FncIntegroDiff f;
-
-    CtcPicard ctc_picard(1.1);
-    ctc_picard.preserve_slicing(true);
-    ctc_picard.contract(f, x, FORWARD | BACKWARD);
-
-    CtcDeriv ctc_deriv;
-    ctc_deriv.preserve_slicing(true);
-    ctc_deriv.contract(x, f.eval_vector(x), FORWARD | BACKWARD);
-}
-
-int main()
+  public:
+
+    ProblemContractor() : m_ctc_picard(1.1)
+    {
+      // Boundary constraints
+      Variable vx0, vx1;
+      SystemFactory fac;
+      fac.add_var(vx0);
+      fac.add_var(vx1);
+      fac.add_ctr(sqr(vx0) + sqr(vx1) = 1);
+      m_sys = new System(fac);
+      m_hc4 = new ibex::CtcHC4(*m_sys);
+
+      m_ctc_picard.preserve_slicing(true);
+      m_ctc_deriv.preserve_slicing(true);
+    }
+
+    ~ProblemContractor()
+    {
+      delete m_hc4;
+      delete m_sys;
+    }
+
+    SolverContractor* clone() const
+    {
+      return new ProblemContractor();
+    }
+
+    void contract(TubeVector& x)
+    {
+      // Boundary constraints
+
+        IntervalVector bounds(2);
+        bounds[0] = x[0](0.);
+        bounds[1] = x[0](1.);
+        m_hc4->contract(bounds);
+        x.set(IntervalVector(1, bounds[0]), 0.);
+        x.set(IntervalVector(1, bounds[1]), 1.);
+
+      // Differential equation
+
+        m_ctc_picard.contract(m_f, x, FORWARD | BACKWARD);
+        m_ctc_deriv.contract(x, m_f.eval_vector(x), FORWARD | BACKWARD);
+    }
+
+  protected:
+
+    System *m_sys;
+    ibex::CtcHC4 *m_hc4;
+    FncIntegroDiff m_f;
+    CtcPicard m_ctc_picard;
+    CtcDeriv m_ctc_deriv;
+};
+
+int main(int argc, char** argv)
 {
   /* =========== PARAMETERS =========== */
 
+    // Arguments: [graphics (0: headless run)] [path of a JSON file for the solver stats] [bisection strategy]
+    bool graphics = argc < 2 || atoi(argv[1]) != 0;
     Tube::enable_syntheses(false);
     int n = 1;
     Vector epsilon(n, 0.1);
@@ -88,13 +115,21 @@ int main()
 
   /* =========== SOLVER =========== */
 
-    tubex::Solver solver(epsilon);
+    tubex::Solver solver(epsilon, graphics);
+    if(argc > 3) // first_component (default) or normalized
+      solver.set_bisection_strategy(BisectionStrategy::from_name(argv[3]));
     solver.set_refining_fxpt_ratio(0.99);
     solver.set_propa_fxpt_ratio(0.9);
     solver.set_cid_fxpt_ratio(0.8);
-    solver.figure()->add_trajectoryvector(&truth1, "truth1");
-    solver.figure()->add_trajectoryvector(&truth2, "truth2");
-    list<TubeVector> l_solutions = solver.solve(x, &contract);
+    if(graphics)
+    {
+      solver.figure()->add_trajectoryvector(&truth1, "truth1");
+      solver.figure()->add_trajectoryvector(&truth2, "truth2");
+    }
+    ProblemContractor ctc;
+    list<TubeVector> l_solutions = solver.solve(x, ctc);
+    if(argc > 2) // figures of the resolution, used by the benchmarks
+      solver.stats().save_json(argv[2]);
 
 
   // Checking if this example still works:
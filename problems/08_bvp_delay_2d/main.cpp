@@ -55,23 +55,40 @@ class FncDelayCustom : public tubex::Fnc
     }
 };
 
-void contract(TubeVector& x)
+class ProblemContractor : public SolverContractor
 {
-  FncDelayCustom f;
+  public:
 
-  CtcPicard ctc_picard(1.1);
-  ctc_picard.preserve_slicing(true);
-  ctc_picard.contract(f, x, FORWARD | BACKWARD);
+    ProblemContractor() : m_ctc_picard(1.1)
+    {
+      m_ctc_picard.preserve_slicing(true);
+      m_ctc_deriv.preserve_slicing(true);
+    }
+
+    SolverContractor* clone() const
+    {
+      return new ProblemContractor();
+    }
 
-  CtcDeriv ctc_deriv;
-  ctc_deriv.preserve_slicing(true);
-  ctc_deriv.contract(x, f.eval_vector(x), FORWARD | BACKWARD);
-}
+    void contract(TubeVector& x)
+    {
+      m_ctc_picard.contract(m_f, x, FORWARD | BACKWARD);
+      m_ctc_deriv.contract(x, m_f.eval_vector(x), FORWARD | BACKWARD);
+    }
+
+  protected:
+
+    FncDelayCustom m_f;
+    CtcPicard m_ctc_picard;
+    CtcDeriv m_ctc_deriv;
+};
 
-int main()
+int main(int argc, char** argv)
 {
   /* =========== PARAMETERS =========== */
 
+    // Arguments: [graphics (0: headless run)] [path of a JSON file for the solver stats] [bisection strategy]
+    bool graphics = argc < 2 || atoi(argv[1]) != 0;
     Tube::enable_syntheses(false);
     int n = 2;
     Vector epsilon(n, 0.4);
@@ -91,11 +108,16 @@ int main()
 
   /* =========== SOLVER =========== */
 
-    tubex::Solver solver(epsilon);
+    tubex::Solver solver(epsilon, graphics);
+    if(argc > 3) // first_component (default) or normalized
+      solver.set_bisection_strategy(BisectionStrategy::from_name(argv[3]));
     solver.set_refining_fxpt_ratio(0.9);
     solver.set_propa_fxpt_ratio(0.9);
     solver.set_cid_fxpt_ratio(0.);
-    list<TubeVector> l_solutions = solver.solve(x, &contract);
+    ProblemContractor ctc;
+    list<TubeVector> l_solutions = solver.solve(x, ctc);
+    if(argc > 2) // figures of the resolution, used by the benchmarks
+      solver.stats().save_json(argv[2]);
 
 
   return EXIT_SUCCESS;
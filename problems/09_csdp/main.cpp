@@ -17,27 +17,46 @@ using namespace std;
 using namespace ibex;
 using namespace tubex;
 
-void contract(TubeVector& x)
+class ProblemContractor : public SolverContractor
 {
-  tubex::Function f("y1", "y2", "(-0.7*y1 ; 0.7*y1 - (ln(2)/5.)*y2)");
+  public:
 
-  CtcPicard ctc_picard;
-  ctc_picard.contract(f, x, FORWARD | BACKWARD);
+    ProblemContractor() : m_f("y1", "y2", "(-0.7*y1 ; 0.7*y1 - (ln(2)/5.)*y2)"), m_fv(m_f)
+    {
 
-  TubeVector v = f.eval_vector(x);
-  CtcDeriv ctc_deriv;
-  ctc_deriv.contract(x, v, FORWARD | BACKWARD);
+    }
 
-  // Check if the following is useful:
-  CtcEval ctc_eval;
-  Interval t(1.,3.);
-  ctc_eval.contract(Interval(1.,3.), Interval(1.1,1.3), x[1], v[1]);
-}
+    SolverContractor* clone() const
+    {
+      return new ProblemContractor();
+    }
 
-int main()
+    void contract(TubeVector& x)
+    {
+      m_ctc_picard.contract(m_f, x, FORWARD | BACKWARD);
+
+      TubeVector& v = m_fv.eval_vector(x); // overwritten by the next evaluation
+      m_ctc_deriv.contract(x, v, FORWARD | BACKWARD);
+
+      // Check if the following is useful:
+      m_ctc_eval.contract(Interval(1.,3.), Interval(1.1,1.3), x[1], v[1]);
+    }
+
+  protected:
+
+    tubex::Function m_f;
+    BatchedFunction m_fv; // derivative tube built in one pass
+    CtcPicard m_ctc_picard;
+    CtcDeriv m_ctc_deriv;
+    CtcEval m_ctc_eval;
+};
+
+int main(int argc, char** argv)
 {
   /* =========== PARAMETERS =========== */
 
+    // Arguments: [graphics (0: headless run)] [path of a JSON file for the solver stats] [bisection strategy]
+    bool graphics = argc < 2 || atoi(argv[1]) != 0;
     Tube::enable_syntheses(false);
     int n = 2;
     Interval domain(0.,6.);
@@ -57,15 +76,21 @@ int main()
 
   /* =========== SOLVER =========== */
 
-    tubex::Solver solver(epsilon);
+    tubex::Solver solver(epsilon, graphics);
+    if(argc > 3) // first_component (default) or normalized
+      solver.set_bisection_strategy(BisectionStrategy::from_name(argv[3]));
     solver.set_refining_fxpt_ratio(0.999);
     solver.set_propa_fxpt_ratio(0.999);
     solver.set_cid_fxpt_ratio(0.);
 
     // Displaying the additional restriction:
-    solver.figure()->draw_box(domain_restriction, max_restriction, "blue");
+    if(graphics)
+      solver.figure()->draw_box(domain_restriction, max_restriction, "blue");
 
-    list<TubeVector> l_solutions = solver.solve(x, &contract);
+    ProblemContractor ctc;
+    list<TubeVector> l_solutions = solver.solve(x, ctc);
+    if(argc > 2) // figures of the resolution, used by the benchmarks
+      solver.stats().save_json(argv[2]);
 
 
   return EXIT_SUCCESS;
@@ -0,0 +1,179 @@
+/** 
+ *  tubex-solve - Runner
+ *  Batch resolution of problem files
+ * ----------------------------------------------------------------------------
+ *
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <thread>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "tubex.h"
+#include "tubex-solve.h"
+
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+static const string PROBLEM_EXTENSION = ".tbx";
+
+// Problem files given by a path: the file itself,
+// or the problem files of a directory (sorted by name)
+static void problem_files(const string& path, vector<string>& v_files)
+{
+  struct stat st;
+  if(stat(path.c_str(), &st) != 0)
+    throw tubex::Exception(__func__, "unable to read " + path);
+
+  if(!S_ISDIR(st.st_mode))
+  {
+    v_files.push_back(path);
+    return;
+  }
+
+  DIR *dir = opendir(path.c_str());
+  if(dir == NULL)
+    throw tubex::Exception(__func__, "unable to read " + path);
+
+  vector<string> v_dir_files;
+  for(struct dirent *e = readdir(dir) ; e != NULL ; e = readdir(dir))
+  {
+    string name = e->d_name;
+    if(name.size() > PROBLEM_EXTENSION.size()
+      && name.compare(name.size() - PROBLEM_EXTENSION.size(), PROBLEM_EXTENSION.size(), PROBLEM_EXTENSION) == 0)
+      v_dir_files.push_back(path + "/" + name);
+  }
+
+  closedir(dir);
+  sort(v_dir_files.begin(), v_dir_files.end());
+  v_files.insert(v_files.end(), v_dir_files.begin(), v_dir_files.end());
+}
+
+// Name of the outputs of a problem: file name without the extension
+static const string problem_name(const string& file_path)
+{
+  string name = file_path.substr(file_path.find_last_of('/') + 1);
+  return name.substr(0, name.find_last_of('.'));
+}
+
+// Resolution of a problem, in a child process
+static int run_problem(const string& file_path, const string& output_dir)
+{
+  try
+  {
+    ProblemFile problem(file_path);
+    string output = output_dir + "/" + problem_name(file_path);
+
+    tubex::Solver solver(problem.epsilon(), false);
+    solver.logger().set_level(SolverLogger::QUIET); // one line per problem
+    problem.configure(solver);
+    solver.set_solution_file(output + ".sol");
+
+    SolverContractor *ctc = problem.contractor();
+    list<TubeVector> l_solutions = solver.solve(problem.initial_tube(), *ctc);
+    delete ctc;
+    solver.stats().save_json(output + ".json");
+
+    printf("%-30s %6d solutions %8d nodes %9.2fs\n", problem_name(file_path).c_str(),
+      solver.stats().nb_solutions, solver.stats().nb_nodes, solver.stats().t_total);
+    fflush(stdout);
+    return EXIT_SUCCESS;
+  }
+
+  catch(exception& e)
+  {
+    fprintf(stderr, "%s: %s\n", file_path.c_str(), e.what());
+    return EXIT_FAILURE;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  // Arguments: [-j number of parallel problems (default: hardware cores)]
+  // [-o output directory (default: .)] problem files or directories...
+  // Each problem is solved in its own process; its stats (name.json) and
+  // solutions (name.sol, see SolutionReader) are written in the output
+  // directory
+
+  int nb_jobs = max(1, (int)thread::hardware_concurrency());
+  string output_dir = ".";
+  vector<string> v_files;
+
+  try
+  {
+    for(int i = 1 ; i < argc ; i++)
+    {
+      if(strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        nb_jobs = max(1, atoi(argv[++i]));
+      else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        output_dir = argv[++i];
+      else
+        problem_files(argv[i], v_files);
+    }
+  }
+
+  catch(exception& e)
+  {
+    fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  if(v_files.empty())
+  {
+    fprintf(stderr, "usage: %s [-j nb_jobs] [-o output_dir] files or directories (*%s)\n",
+      argv[0], PROBLEM_EXTENSION.c_str());
+    return EXIT_FAILURE;
+  }
+
+  if(mkdir(output_dir.c_str(), 0755) != 0 && errno != EEXIST)
+  {
+    perror(output_dir.c_str());
+    return EXIT_FAILURE;
+  }
+
+  Tube::enable_syntheses(false);
+  fflush(stdout);
+
+  int nb_running = 0, nb_failures = 0;
+  for(size_t k = 0 ; k < v_files.size() || nb_running > 0 ; )
+  {
+    if(k < v_files.size() && nb_running < nb_jobs)
+    {
+      pid_t pid = fork();
+      if(pid == -1)
+      {
+        perror("fork");
+        return EXIT_FAILURE;
+      }
+
+      if(pid == 0)
+        _exit(run_problem(v_files[k], output_dir));
+
+      nb_running++;
+      k++;
+      continue;
+    }
+
+    int status;
+    if(wait(&status) == -1)
+      break;
+    nb_running--;
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+      nb_failures++;
+  }
+
+  if(nb_failures > 0)
+    fprintf(stderr, "%d problem(s) failed\n", nb_failures);
+  return nb_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
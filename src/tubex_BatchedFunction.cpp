@@ -0,0 +1,157 @@
+/** 
+ *  BatchedFunction class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex_BatchedFunction.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  BatchedFunction::BatchedFunction(const Function& f)
+  {
+    // Same variables as f, with the time first
+    vector<string> v_names(1, "t");
+    for(int i = 0 ; i < f.nb_vars() ; i++)
+      v_names.push_back(f.arg_name(i));
+
+    vector<const char*> v_args;
+    for(size_t i = 0 ; i < v_names.size() ; i++)
+      v_args.push_back(v_names[i].c_str());
+
+    m_f = new ibex::Function(v_args.size(), v_args.data(), f.expr().c_str());
+    m_box = IntervalVector(v_args.size());
+    assert(m_f->image_dim() == f.image_dim());
+  }
+
+  BatchedFunction::~BatchedFunction()
+  {
+    delete m_f;
+    delete m_v;
+  }
+
+  int BatchedFunction::image_dim() const
+  {
+    return m_f->image_dim();
+  }
+
+  TubeVector& BatchedFunction::eval_vector(const TubeVector& x, const Interval& t_window)
+  {
+    assert(x.size() == m_box.size() - 1);
+    assert(x.size() == image_dim() && "derivative of x expected");
+
+    int n = x.size();
+    vector<const Slice*> v_x(n);
+    vector<Slice*> v_v(n);
+    vector<Interval> v_values(n);
+    IntervalVector y(n);
+
+    // The previous result is reused if its slicing is the one of x
+    bool same_slicing = m_v != NULL;
+    for(int i = 0 ; same_slicing && i < n ; i++)
+      same_slicing = (*m_v)[i].nb_slices() == x[i].nb_slices();
+    for(int i = 0 ; same_slicing && i < n ; i++)
+    {
+      const Slice *s_x = x[i].first_slice();
+      for(const Slice *s_v = (*m_v)[i].first_slice() ; same_slicing && s_v != NULL ; s_v = s_v->next_slice(), s_x = s_x->next_slice())
+        same_slicing = s_v->domain() == s_x->domain();
+    }
+
+    if(!same_slicing)
+    {
+      delete m_v;
+      m_v = new TubeVector(x, IntervalVector(n));
+    }
+
+    for(int i = 0 ; i < n ; i++)
+    {
+      v_x[i] = x[i].first_slice();
+      v_v[i] = (*m_v)[i].first_slice();
+    }
+
+    // Slices out of t_window are set to [-oo,oo], as are the gates they
+    // do not share with an evaluated slice: no value of a previous call,
+    // possibly contracted by the caller, remains in the result
+    bool prev_evaluated = false;
+    while(v_x[0] != NULL)
+    {
+      const Interval& domain = v_x[0]->domain();
+      bool evaluated = domain.intersects(t_window);
+
+      if(evaluated)
+      {
+        for(int i = 0 ; i < n ; i++)
+          v_values[i] = v_x[i]->codomain();
+        eval(domain, v_values, y);
+      }
+
+      else
+        y = IntervalVector(n);
+
+      for(int i = 0 ; i < n ; i++)
+        v_v[i]->set_envelope(y[i], false);
+
+      if(evaluated || prev_evaluated) // else, gate out of the window
+      {
+        for(int i = 0 ; i < n ; i++)
+          v_values[i] = v_x[i]->input_gate();
+        eval(Interval(domain.lb()), v_values, y);
+      }
+
+      else
+        y = IntervalVector(n);
+
+      for(int i = 0 ; i < n ; i++)
+        v_v[i]->set_input_gate(y[i], false);
+
+      if(v_x[0]->next_slice() == NULL) // final gate
+      {
+        if(evaluated)
+        {
+          for(int i = 0 ; i < n ; i++)
+            v_values[i] = v_x[i]->output_gate();
+          eval(Interval(domain.ub()), v_values, y);
+        }
+
+        else
+          y = IntervalVector(n);
+
+        for(int i = 0 ; i < n ; i++)
+          v_v[i]->set_output_gate(y[i], false);
+      }
+
+      prev_evaluated = evaluated;
+      for(int i = 0 ; i < n ; i++)
+      {
+        v_x[i] = v_x[i]->next_slice();
+        v_v[i] = v_v[i]->next_slice();
+      }
+    }
+
+    return *m_v;
+  }
+
+  void BatchedFunction::eval(const Interval& t, const vector<Interval>& v_x, IntervalVector& y)
+  {
+    m_box[0] = t;
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+    {
+      if(v_x[i].is_empty())
+      {
+        y.set_empty();
+        return;
+      }
+
+      m_box[i + 1] = v_x[i];
+    }
+
+    y = m_f->eval_vector(m_box);
+  }
+}
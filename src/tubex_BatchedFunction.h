@@ -0,0 +1,60 @@
+/** 
+ *  BatchedFunction class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_BATCHEDFUNCTION_H__
+#define __TUBEX_BATCHEDFUNCTION_H__
+
+#include <vector>
+#include <ibex.h>
+#include "tubex_TubeVector.h"
+#include "tubex_Function.h"
+
+namespace tubex
+{
+  /**
+   * Evaluation of a tubex::Function f(t,x) over all the slices of a tube,
+   * to build the derivative tube consumed by CtcDeriv.
+   *
+   * The expression is compiled once into an ibex::Function of (t,x)
+   * (outward rounded interval evaluation). The slices of x and of the
+   * result are then walked together in one pass, with a single box
+   * reused for all the evaluations: no slice lookup by index, and no
+   * allocation once the slicing of x is stable.
+   * Note: not thread-safe, each SolverContractor owns its instance
+   */
+  class BatchedFunction
+  {
+    public:
+
+      BatchedFunction(const Function& f);
+      ~BatchedFunction();
+      BatchedFunction(const BatchedFunction&) = delete;
+      BatchedFunction& operator=(const BatchedFunction&) = delete;
+
+      int image_dim() const;
+
+      // Tube v = f(t,x) (envelopes and gates), with the slicing of x.
+      // Only the slices intersecting t_window are evaluated: the others
+      // are set to [-oo,oo]. The returned tube is kept by the object: it
+      // may be contracted by the caller, but is overwritten by the next
+      // evaluation (the reference is valid until then)
+      TubeVector& eval_vector(const TubeVector& x, const ibex::Interval& t_window = ibex::Interval::ALL_REALS);
+
+    protected:
+
+      void eval(const ibex::Interval& t, const std::vector<ibex::Interval>& v_x, ibex::IntervalVector& y);
+
+      ibex::Function *m_f; // compiled expression of (t,x)
+      ibex::IntervalVector m_box = ibex::IntervalVector(1); // evaluation point (t,x)
+      TubeVector *m_v = NULL; // last result
+  };
+}
+
+#endif
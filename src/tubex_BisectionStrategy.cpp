@@ -0,0 +1,195 @@
+/** 
+ *  BisectionStrategy classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include "tubex_BisectionStrategy.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  BisectionStrategy::~BisectionStrategy()
+  {
+
+  }
+
+  const BisectionStrategy& BisectionStrategy::from_name(const string& name)
+  {
+    static const FirstComponentBisection first_component;
+    static const NormalizedBisection normalized;
+
+    if(name == first_component.name())
+      return first_component;
+    if(name == normalized.name())
+      return normalized;
+    throw Exception(__func__, "unknown bisection strategy " + name);
+  }
+
+  void BisectionStrategy::refining_times(const TubeVector& x, const Vector& max_thickness, int nb, vector<double>& v_t) const
+  {
+    assert(nb > 0);
+    assert(x.size() == max_thickness.size());
+
+    vector<pair<double,double> > v_scores; // (score, time)
+    for(int i = 0 ; i < x.size() ; i++)
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        double score = refining_score(*s, i, max_thickness);
+        if(score >= 0.)
+          v_scores.push_back(make_pair(score, s->domain().mid()));
+      }
+
+    // Highest scores first; equal scores in chronological order
+    stable_sort(v_scores.begin(), v_scores.end(),
+      [](const pair<double,double>& a, const pair<double,double>& b) { return a.first > b.first; });
+
+    v_t.clear();
+    for(size_t k = 0 ; k < v_scores.size() && (int)v_t.size() < nb ; k++)
+      if(find(v_t.begin(), v_t.end(), v_scores[k].second) == v_t.end())
+        v_t.push_back(v_scores[k].second);
+  }
+
+  void BisectionStrategy::cid_times(const TubeVector& x, const Vector& max_thickness, int nb, vector<double>& v_t) const
+  {
+    assert(nb > 0);
+    assert(x.size() == max_thickness.size());
+
+    v_t.clear();
+    v_t.push_back(cid_time(x, max_thickness));
+    if(nb == 1)
+      return;
+
+    vector<pair<double,double> > v_scores; // (score, time) of the widest gate of each component
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      pair<double,double> widest(x[i].last_slice()->output_gate().diam(), x[i].domain().ub());
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+        if(s->input_gate().diam() > widest.first)
+          widest = make_pair(s->input_gate().diam(), s->domain().lb());
+      widest.first /= max_thickness[i];
+      v_scores.push_back(widest);
+    }
+
+    stable_sort(v_scores.begin(), v_scores.end(),
+      [](const pair<double,double>& a, const pair<double,double>& b) { return a.first > b.first; });
+
+    for(size_t k = 0 ; k < v_scores.size() && (int)v_t.size() < nb ; k++)
+      if(find(v_t.begin(), v_t.end(), v_scores[k].second) == v_t.end())
+        v_t.push_back(v_scores[k].second);
+  }
+
+  // FirstComponentBisection
+
+  const string FirstComponentBisection::name() const
+  {
+    return "first_component";
+  }
+
+  double FirstComponentBisection::bisection_time(const TubeVector& x, const Vector&) const
+  {
+    return x[0].largest_slice()->domain().mid();
+  }
+
+  int FirstComponentBisection::bisection_component(const IntervalVector& gate, const Vector&) const
+  {
+    // Largest component, as chosen by ibex::LargestFirst
+    int i_max = 0;
+    for(int i = 1 ; i < gate.size() ; i++)
+      if(gate[i].diam() > gate[i_max].diam())
+        i_max = i;
+    return i_max;
+  }
+
+  double FirstComponentBisection::refining_score(const Slice& s, int i, const Vector&) const
+  {
+    return i == 0 ? s.domain().diam() : -1.; // wider slices of x[0]
+  }
+
+  double FirstComponentBisection::cid_time(const TubeVector& x, const Vector&) const
+  {
+    double t;
+    x[0].max_gate_diam(t);
+    return t;
+  }
+
+  // NormalizedBisection
+
+  const string NormalizedBisection::name() const
+  {
+    return "normalized";
+  }
+
+  double NormalizedBisection::bisection_time(const TubeVector& x, const Vector& max_thickness) const
+  {
+    assert(x.size() == max_thickness.size());
+
+    double t = x.domain().mid(), max_score = -1.;
+    for(int i = 0 ; i < x.size() ; i++)
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        double score = s->codomain().diam() / max_thickness[i];
+        if(score > max_score)
+        {
+          max_score = score;
+          t = s->domain().mid();
+        }
+      }
+
+    return t;
+  }
+
+  int NormalizedBisection::bisection_component(const IntervalVector& gate, const Vector& max_thickness) const
+  {
+    assert(gate.size() == max_thickness.size());
+
+    int i_max = 0;
+    for(int i = 1 ; i < gate.size() ; i++)
+      if(gate[i].diam() / max_thickness[i] > gate[i_max].diam() / max_thickness[i_max])
+        i_max = i;
+    return i_max;
+  }
+
+  double NormalizedBisection::refining_score(const Slice& s, int i, const Vector& max_thickness) const
+  {
+    // Slices are scored by their area, so that thin slices
+    // are not refined because of their length only
+    return s.domain().diam() * s.codomain().diam() / max_thickness[i];
+  }
+
+  double NormalizedBisection::cid_time(const TubeVector& x, const Vector& max_thickness) const
+  {
+    assert(x.size() == max_thickness.size());
+
+    double t = x.domain().lb(), max_score = -1.;
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        double score = s->input_gate().diam() / max_thickness[i];
+        if(score > max_score)
+        {
+          max_score = score;
+          t = s->domain().lb();
+        }
+      }
+
+      double score = x[i].last_slice()->output_gate().diam() / max_thickness[i];
+      if(score > max_score)
+      {
+        max_score = score;
+        t = x[i].domain().ub();
+      }
+    }
+
+    return t;
+  }
+}
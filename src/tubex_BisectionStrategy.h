@@ -0,0 +1,96 @@
+/** 
+ *  BisectionStrategy classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_BISECTIONSTRATEGY_H__
+#define __TUBEX_BISECTIONSTRATEGY_H__
+
+#include <string>
+#include <vector>
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * Choice of the times at which the Solver bisects, refines
+   * and applies the CID on a tube.
+   *
+   * max_thickness is the precision expected from the solutions (see
+   * Solver): it can be used to compare components of different scales.
+   * Strategies have no state, and are shared by the solver threads.
+   */
+  class BisectionStrategy
+  {
+    public:
+
+      virtual ~BisectionStrategy();
+      virtual const std::string name() const = 0;
+
+      // Time of the bisection of the gate x(t)
+      virtual double bisection_time(const TubeVector& x, const ibex::Vector& max_thickness) const = 0;
+      // Component bisected in the gate (also used by the CID splits)
+      virtual int bisection_component(const ibex::IntervalVector& gate, const ibex::Vector& max_thickness) const = 0;
+      // Times of the next samplings of x: middles of the nb slices
+      // of highest refining score (at most one time per slice domain)
+      void refining_times(const TubeVector& x, const ibex::Vector& max_thickness, int nb, std::vector<double>& v_t) const;
+      // Time of the gate split by the CID
+      virtual double cid_time(const TubeVector& x, const ibex::Vector& max_thickness) const = 0;
+      // Times of the gates split by a CID sweep: cid_time() first, then
+      // the times of the widest gates of the components (diameters divided
+      // by the expected thickness), at most nb distinct times
+      void cid_times(const TubeVector& x, const ibex::Vector& max_thickness, int nb, std::vector<double>& v_t) const;
+
+      // Built-in strategy of the given name
+      // (throws an Exception for an unknown name)
+      static const BisectionStrategy& from_name(const std::string& name);
+
+    protected:
+
+      // Score of the slice s of the component i (negative: not refined)
+      virtual double refining_score(const Slice& s, int i, const ibex::Vector& max_thickness) const = 0;
+  };
+
+  // Strategy of the first versions of the solver: only the first
+  // component is considered (uncertain slice, wider slice, wider gate),
+  // the gate being bisected along its largest component
+
+  class FirstComponentBisection : public BisectionStrategy
+  {
+    public:
+
+      const std::string name() const;
+      double bisection_time(const TubeVector& x, const ibex::Vector& max_thickness) const;
+      int bisection_component(const ibex::IntervalVector& gate, const ibex::Vector& max_thickness) const;
+      double cid_time(const TubeVector& x, const ibex::Vector& max_thickness) const;
+
+    protected:
+
+      double refining_score(const Slice& s, int i, const ibex::Vector& max_thickness) const;
+  };
+
+  // All the components are considered, each diameter being divided
+  // by the expected thickness of its component: the search splits
+  // the component that is the farthest from the stopping condition
+
+  class NormalizedBisection : public BisectionStrategy
+  {
+    public:
+
+      const std::string name() const;
+      double bisection_time(const TubeVector& x, const ibex::Vector& max_thickness) const;
+      int bisection_component(const ibex::IntervalVector& gate, const ibex::Vector& max_thickness) const;
+      double cid_time(const TubeVector& x, const ibex::Vector& max_thickness) const;
+
+    protected:
+
+      double refining_score(const Slice& s, int i, const ibex::Vector& max_thickness) const;
+  };
+}
+
+#endif
@@ -0,0 +1,104 @@
+/** 
+ *  EnvelopeIndex class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include "tubex_EnvelopeIndex.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  EnvelopeIndex::EnvelopeIndex(const Interval& range, int nb_cells)
+    : m_range(range), m_cell_width(0.)
+  {
+    assert(nb_cells > 0);
+
+    // Without a bounded range, all boxes are kept aside
+    if(!range.is_empty() && !range.is_unbounded() && range.diam() > 0.)
+    {
+      m_cells.resize(nb_cells);
+      m_cell_width = range.diam() / nb_cells;
+    }
+  }
+
+  pair<int,int> EnvelopeIndex::cells(const Interval& x) const
+  {
+    if(m_cells.empty() || x.is_empty() || !x.is_subset(m_range))
+      return make_pair(-1, -1);
+
+    int nb_cells = m_cells.size();
+    int lb = std::min(nb_cells - 1, (int)((x.lb() - m_range.lb()) / m_cell_width));
+    int ub = std::min(nb_cells - 1, (int)((x.ub() - m_range.lb()) / m_cell_width));
+
+    if(ub - lb + 1 > std::max(1, nb_cells / 4)) // too wide to be worth indexing
+      return make_pair(-1, -1);
+
+    return make_pair(lb, ub);
+  }
+
+  void EnvelopeIndex::insert(int id, const IntervalVector& box)
+  {
+    assert(m_boxes.find(id) == m_boxes.end());
+    m_boxes.insert(make_pair(id, box));
+
+    pair<int,int> c = cells(box[0]);
+    if(c.first == -1)
+      m_aside.push_back(id);
+
+    else
+      for(int i = c.first ; i <= c.second ; i++)
+        m_cells[i].push_back(id);
+  }
+
+  void EnvelopeIndex::remove(int id)
+  {
+    map<int,IntervalVector>::iterator it = m_boxes.find(id);
+    assert(it != m_boxes.end());
+
+    pair<int,int> c = cells(it->second[0]);
+    if(c.first == -1)
+      m_aside.erase(std::find(m_aside.begin(), m_aside.end(), id));
+
+    else
+      for(int i = c.first ; i <= c.second ; i++)
+        m_cells[i].erase(std::find(m_cells[i].begin(), m_cells[i].end(), id));
+
+    m_boxes.erase(it);
+  }
+
+  void EnvelopeIndex::intersecting(const IntervalVector& box, vector<int>& v_ids) const
+  {
+    v_ids.clear();
+    v_ids.insert(v_ids.end(), m_aside.begin(), m_aside.end());
+
+    Interval x = box[0] & m_range;
+    pair<int,int> c = make_pair(0, -1); // no cell
+    if(!x.is_empty() && !m_cells.empty())
+    {
+      c = cells(x);
+      if(c.first == -1) // wide query: all cells are candidates
+        c = make_pair(0, (int)m_cells.size() - 1);
+    }
+
+    for(int i = c.first ; i <= c.second ; i++)
+      v_ids.insert(v_ids.end(), m_cells[i].begin(), m_cells[i].end());
+
+    sort(v_ids.begin(), v_ids.end());
+    v_ids.erase(unique(v_ids.begin(), v_ids.end()), v_ids.end());
+
+    // Exact test on all the components
+    size_t k = 0;
+    for(size_t i = 0 ; i < v_ids.size() ; i++)
+      if(m_boxes.find(v_ids[i])->second.intersects(box))
+        v_ids[k++] = v_ids[i];
+    v_ids.resize(k);
+  }
+}
@@ -0,0 +1,54 @@
+/** 
+ *  EnvelopeIndex class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_ENVELOPEINDEX_H__
+#define __TUBEX_ENVELOPEINDEX_H__
+
+#include <vector>
+#include <map>
+#include <ibex.h>
+
+namespace tubex
+{
+  /**
+   * Spatial index of boxes (typically the envelopes of tubes), used to
+   * find the boxes intersecting a given one without scanning them all.
+   *
+   * Boxes are registered in the cells of a regular grid over their first
+   * component. Boxes that are unbounded, or spread over a large part of
+   * the grid, are kept aside and returned as candidates of any query.
+   */
+  class EnvelopeIndex
+  {
+    public:
+
+      // range: hull of the first components of the boxes to be indexed
+      EnvelopeIndex(const ibex::Interval& range, int nb_cells);
+
+      void insert(int id, const ibex::IntervalVector& box);
+      void remove(int id);
+
+      // Identifiers of the indexed boxes intersecting box, in increasing order
+      void intersecting(const ibex::IntervalVector& box, std::vector<int>& v_ids) const;
+
+    protected:
+
+      // Range of cells crossed by x, or (-1,-1) if not indexed in the grid
+      std::pair<int,int> cells(const ibex::Interval& x) const;
+
+      ibex::Interval m_range;
+      double m_cell_width;
+      std::vector<std::vector<int> > m_cells;
+      std::vector<int> m_aside; // boxes not indexed in the grid
+      std::map<int,ibex::IntervalVector> m_boxes;
+  };
+}
+
+#endif
@@ -0,0 +1,392 @@
+/** 
+ *  ProblemFile class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include "tubex_ProblemFile.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  static const string trim(const string& s)
+  {
+    size_t lb = s.find_first_not_of(" \t\r");
+    if(lb == string::npos)
+      return "";
+    size_t ub = s.find_last_not_of(" \t\r");
+    return s.substr(lb, ub - lb + 1);
+  }
+
+  static double parse_double(const string& s)
+  {
+    string v = trim(s);
+    if(v == "oo" || v == "+oo")
+      return POS_INFINITY;
+    if(v == "-oo")
+      return NEG_INFINITY;
+
+    char *end;
+    double d = strtod(v.c_str(), &end);
+    if(v.empty() || *end != '\0')
+      throw Exception(__func__, "invalid number \"" + v + "\"");
+    return d;
+  }
+
+  // Next interval of s: a number, [x] or [lb,ub]
+  static bool parse_interval(istringstream& s, Interval& x)
+  {
+    s >> ws;
+    if(s.eof())
+      return false;
+
+    string token;
+    if(s.peek() == '[')
+    {
+      getline(s, token, ']');
+      if(s.fail())
+        throw Exception(__func__, "invalid interval \"" + token + "\"");
+
+      // [x] is the degenerate interval [x,x]
+      size_t comma = token.find(',');
+      double lb = parse_double(token.substr(1, comma == string::npos ? string::npos : comma - 1));
+      double ub = comma == string::npos ? lb : parse_double(token.substr(comma + 1));
+      if(lb > ub)
+        throw Exception(__func__, "empty interval \"" + token + "]\"");
+      x = Interval(lb, ub);
+    }
+
+    else
+    {
+      s >> token;
+      x = Interval(parse_double(token));
+    }
+
+    return true;
+  }
+
+  ProblemFile::ProblemFile(const string& file_path)
+  {
+    ifstream f(file_path.c_str());
+    if(!f.is_open())
+      throw Exception(__func__, "unable to open " + file_path);
+
+    string line;
+    int ode_line = 0;
+    for(int nb_line = 1 ; getline(f, line) ; nb_line++)
+    {
+      line = trim(line.substr(0, line.find('#')));
+      if(line.empty())
+        continue;
+
+      size_t colon = line.find(':');
+      if(colon == string::npos)
+      {
+        ostringstream o;
+        o << file_path << ":" << nb_line << ": \"key: value\" expected";
+        throw Exception(__func__, o.str());
+      }
+
+      try
+      {
+        string key = trim(line.substr(0, colon));
+        parse(key, trim(line.substr(colon + 1)));
+        if(key == "ode")
+          ode_line = nb_line;
+      }
+
+      catch(Exception& e)
+      {
+        ostringstream o;
+        o << file_path << ":" << nb_line << ": " << e.what();
+        throw Exception(__func__, o.str());
+      }
+    }
+
+    if(m_variables.empty() || m_ode.empty() || m_domain.is_empty())
+      throw Exception(__func__, file_path + ": variables, ode and domain expected");
+
+    // The ode is checked now (once the variables are known),
+    // rather than when the contractors are built by the solver
+    try
+    {
+      delete OdeContractor::ode_function(m_variables, m_ode);
+    }
+
+    catch(Exception& e)
+    {
+      ostringstream o;
+      o << file_path << ":" << ode_line << ": " << e.what();
+      throw Exception(__func__, o.str());
+    }
+
+    // Boxes given by a single interval are set for all the components
+
+    int n = size();
+    if(!m_epsilon_set)
+      throw Exception(__func__, file_path + ": epsilon expected");
+    if(m_epsilon.size() == 1 && n > 1)
+      m_epsilon = Vector(n, m_epsilon[0]);
+    if(m_epsilon.size() != n)
+      throw Exception(__func__, file_path + ": epsilon does not match the number of variables");
+
+    m_codomain = !m_codomain_set ? IntervalVector(n)
+               : m_codomain.size() == 1 ? IntervalVector(n, m_codomain[0]) : m_codomain;
+    if(m_codomain.size() != n)
+      throw Exception(__func__, file_path + ": codomain does not match the number of variables");
+
+    for(size_t i = 0 ; i < m_conditions.size() ; i++)
+    {
+      if(m_conditions[i].second.size() == 1)
+        m_conditions[i].second = IntervalVector(n, m_conditions[i].second[0]);
+      if(m_conditions[i].second.size() != n || !m_domain.contains(m_conditions[i].first))
+        throw Exception(__func__, file_path + ": invalid condition");
+    }
+
+    for(size_t i = 0 ; i < m_restrictions.size() ; i++)
+    {
+      if(m_restrictions[i].second.size() == 1)
+        m_restrictions[i].second = IntervalVector(n, m_restrictions[i].second[0]);
+      if(m_restrictions[i].second.size() != n || !m_restrictions[i].first.is_subset(m_domain))
+        throw Exception(__func__, file_path + ": invalid restriction");
+    }
+  }
+
+  void ProblemFile::parse(const string& key, const string& value)
+  {
+    istringstream s(value);
+
+    if(key == "variables")
+    {
+      m_variables.clear();
+      string name;
+      while(s >> name)
+        m_variables.push_back(name);
+    }
+
+    else if(key == "ode")
+      m_ode = value;
+
+    else if(key == "domain")
+    {
+      if(!parse_interval(s, m_domain) || !(s >> ws).eof())
+        throw Exception(__func__, "one interval expected");
+    }
+
+    else if(key == "codomain")
+    {
+      m_codomain = parse_box(s);
+      m_codomain_set = true;
+    }
+
+    else if(key == "timestep")
+    {
+      m_timestep = parse_double(value);
+      if(m_timestep < 0.)
+        throw Exception(__func__, "positive timestep expected");
+    }
+
+    else if(key == "condition")
+    {
+      string t;
+      s >> t;
+      m_conditions.push_back(make_pair(parse_double(t), parse_box(s)));
+    }
+
+    else if(key == "restriction")
+    {
+      Interval t;
+      if(!parse_interval(s, t))
+        throw Exception(__func__, "time interval expected");
+      m_restrictions.push_back(make_pair(t, parse_box(s)));
+    }
+
+    else if(key == "propagation")
+    {
+      if(value == "forward") m_propagation = FORWARD;
+      else if(value == "backward") m_propagation = BACKWARD;
+      else if(value == "both") m_propagation = FORWARD | BACKWARD;
+      else throw Exception(__func__, "forward, backward or both expected");
+    }
+
+    else if(key == "epsilon")
+    {
+      vector<double> v_epsilon;
+      string token;
+      while(s >> token)
+      {
+        v_epsilon.push_back(parse_double(token));
+        if(!(v_epsilon.back() > 0.))
+          throw Exception(__func__, "positive values expected");
+      }
+
+      if(v_epsilon.empty())
+        throw Exception(__func__, "positive values expected");
+      m_epsilon = Vector(v_epsilon.size());
+      for(size_t i = 0 ; i < v_epsilon.size() ; i++)
+        m_epsilon[i] = v_epsilon[i];
+      m_epsilon_set = true;
+    }
+
+    else if(key == "strategy")
+    {
+      BisectionStrategy::from_name(value); // unknown strategies are rejected here
+      m_strategy = value;
+    }
+
+    else if(key == "refining_fxpt_ratio" || key == "propa_fxpt_ratio" || key == "cid_fxpt_ratio"
+         || key == "clustering_ratio")
+    {
+      double ratio = parse_double(value);
+      if(ratio < 0. || ratio > 1.)
+        throw Exception(__func__, "ratio in [0,1] expected");
+      m_parameters[key] = ratio;
+    }
+
+    else if(key == "max_refining_batch" || key == "max_solutions" || key == "time_limit"
+         || key == "max_nodes")
+    {
+      double param = parse_double(value);
+      if(param < 0. || (key == "max_refining_batch" && param < 1.))
+        throw Exception(__func__, "invalid value for " + key);
+      m_parameters[key] = param;
+    }
+
+    else
+      throw Exception(__func__, "unknown key \"" + key + "\"");
+  }
+
+  const IntervalVector ProblemFile::parse_box(istringstream& s) const
+  {
+    vector<Interval> v_x;
+    Interval x;
+    while(parse_interval(s, x))
+      v_x.push_back(x);
+
+    if(v_x.empty())
+      throw Exception(__func__, "box expected");
+
+    IntervalVector box(v_x.size());
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+      box[i] = v_x[i];
+    return box;
+  }
+
+  int ProblemFile::size() const
+  {
+    return m_variables.size();
+  }
+
+  const Vector& ProblemFile::epsilon() const
+  {
+    return m_epsilon;
+  }
+
+  const TubeVector ProblemFile::initial_tube() const
+  {
+    TubeVector x = m_timestep == 0. ? TubeVector(m_domain, m_codomain)
+                                    : TubeVector(m_domain, m_timestep, m_codomain);
+
+    for(size_t i = 0 ; i < m_restrictions.size() ; i++)
+      x.set(m_restrictions[i].second, m_restrictions[i].first);
+
+    for(size_t i = 0 ; i < m_conditions.size() ; i++)
+      x.set(m_conditions[i].second, m_conditions[i].first);
+
+    return x;
+  }
+
+  void ProblemFile::configure(Solver& solver) const
+  {
+    if(!m_strategy.empty())
+      solver.set_bisection_strategy(BisectionStrategy::from_name(m_strategy));
+
+    for(map<string,double>::const_iterator it = m_parameters.begin() ; it != m_parameters.end() ; ++it)
+    {
+      if(it->first == "refining_fxpt_ratio") solver.set_refining_fxpt_ratio(it->second);
+      else if(it->first == "propa_fxpt_ratio") solver.set_propa_fxpt_ratio(it->second);
+      else if(it->first == "cid_fxpt_ratio") solver.set_cid_fxpt_ratio(it->second);
+      else if(it->first == "clustering_ratio") solver.set_clustering_ratio(it->second);
+      else if(it->first == "max_refining_batch") solver.set_max_refining_batch((int)it->second);
+      else if(it->first == "max_solutions") solver.set_max_solutions((int)it->second);
+      else if(it->first == "time_limit") solver.set_time_limit(it->second);
+      else if(it->first == "max_nodes") solver.set_max_nodes((int)it->second);
+    }
+  }
+
+  SolverContractor* ProblemFile::contractor() const
+  {
+    return new OdeContractor(m_variables, m_ode, m_propagation);
+  }
+
+  // OdeContractor
+
+  OdeContractor::OdeContractor(const vector<string>& variables, const string& ode, TimePropag propagation)
+    : m_variables(variables), m_ode(ode), m_propagation(propagation)
+  {
+    m_f = ode_function(variables, ode);
+    m_fv = new BatchedFunction(*m_f);
+    m_ctc_deriv.set_fast_mode(true);
+  }
+
+  OdeContractor::~OdeContractor()
+  {
+    delete m_fv;
+    delete m_f;
+  }
+
+  void OdeContractor::contract(TubeVector& x)
+  {
+    m_ctc_picard.contract(*m_f, x, m_propagation);
+    m_ctc_deriv.contract(x, m_fv->eval_vector(x), FORWARD | BACKWARD);
+  }
+
+  SolverContractor* OdeContractor::clone() const
+  {
+    return new OdeContractor(m_variables, m_ode, m_propagation);
+  }
+
+  Function* OdeContractor::ode_function(const vector<string>& variables, const string& ode)
+  {
+    vector<const char*> v_args;
+    for(size_t i = 0 ; i < variables.size() ; i++)
+      v_args.push_back(variables[i].c_str());
+
+    // IBEX errors are not std::exceptions
+    Function *f;
+    try
+    {
+      f = new Function(v_args.size(), v_args.data(), ode.c_str());
+    }
+
+    catch(ibex::SyntaxError& e)
+    {
+      ostringstream o;
+      o << "invalid ode: " << e;
+      throw Exception(__func__, o.str());
+    }
+
+    catch(ibex::Exception&)
+    {
+      throw Exception(__func__, "invalid ode");
+    }
+
+    if(f->image_dim() != (int)variables.size())
+    {
+      delete f;
+      throw Exception(__func__, "the ode does not match the number of variables");
+    }
+
+    return f;
+  }
+}
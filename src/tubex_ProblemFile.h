@@ -0,0 +1,121 @@
+/** 
+ *  ProblemFile class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_PROBLEMFILE_H__
+#define __TUBEX_PROBLEMFILE_H__
+
+#include <string>
+#include <vector>
+#include <map>
+#include "tubex_TubeVector.h"
+#include "tubex_Function.h"
+#include "tubex_CtcPicard.h"
+#include "tubex_CtcDeriv.h"
+#include "tubex_Solver.h"
+#include "tubex_SolverContractor.h"
+#include "tubex_BatchedFunction.h"
+
+namespace tubex
+{
+  /**
+   * Problem x' = f(x) described by a text file, solved without compiling
+   * a dedicated program (see the runner). One entry per line, "key: value",
+   * '#' starting a comment:
+   *
+   *   variables: y1 y2                  (names used by the ode)
+   *   ode: (-0.7*y1 ; 0.7*y1 - y2)      (tubex::Function syntax)
+   *   domain: [0,6]
+   *   codomain: [-9999,9999]            (initial envelope, optional)
+   *   timestep: 0.1                     (initial slicing, optional)
+   *   condition: 0 [1.25] [-oo,oo]      (gate at a time, repeatable)
+   *   restriction: [1,3] [-oo,oo] [1.1,1.3] (envelope over a time
+   *                                      interval, repeatable)
+   *   propagation: forward              (of the Picard contractor:
+   *                                      forward, backward or both)
+   *   epsilon: 0.15                     (max thickness of the solutions)
+   *
+   * and the solver parameters: strategy, refining_fxpt_ratio,
+   * propa_fxpt_ratio, cid_fxpt_ratio, max_refining_batch,
+   * clustering_ratio, max_solutions, time_limit, max_nodes.
+   * A box is given by one interval per component, or by a single interval
+   * for all of them; an interval is either a number, [x] or [lb,ub],
+   * where bounds may be -oo or oo.
+   */
+  class ProblemFile
+  {
+    public:
+
+      // Throws an Exception (with the line of the error) if the file
+      // cannot be read or is not a valid problem
+      ProblemFile(const std::string& file_path);
+
+      int size() const;
+      const ibex::Vector& epsilon() const;
+      const TubeVector initial_tube() const;
+
+      // Solver parameters given by the file
+      void configure(Solver& solver) const;
+
+      // Contractor of the ode (to be deleted by the caller)
+      SolverContractor* contractor() const;
+
+    protected:
+
+      void parse(const std::string& key, const std::string& value);
+      const ibex::IntervalVector parse_box(std::istringstream& s) const;
+
+      std::vector<std::string> m_variables;
+      std::string m_ode;
+      ibex::Interval m_domain = ibex::Interval::EMPTY_SET;
+      ibex::IntervalVector m_codomain = ibex::IntervalVector(1);
+      bool m_codomain_set = false;
+      double m_timestep = 0.;
+      std::vector<std::pair<double,ibex::IntervalVector> > m_conditions;
+      std::vector<std::pair<ibex::Interval,ibex::IntervalVector> > m_restrictions;
+      TimePropag m_propagation = FORWARD | BACKWARD;
+      ibex::Vector m_epsilon = ibex::Vector(1);
+      bool m_epsilon_set = false;
+      std::string m_strategy;
+      std::map<std::string,double> m_parameters; // numerical solver parameters
+  };
+
+  /**
+   * Contractor of x' = f(x): CtcPicard (in the given direction),
+   * then CtcDeriv (forward and backward)
+   */
+  class OdeContractor : public SolverContractor
+  {
+    public:
+
+      OdeContractor(const std::vector<std::string>& variables, const std::string& ode, TimePropag propagation);
+      ~OdeContractor();
+      OdeContractor(const OdeContractor&) = delete;
+      OdeContractor& operator=(const OdeContractor&) = delete;
+
+      void contract(TubeVector& x);
+      SolverContractor* clone() const;
+
+      // Function of the ode (to be deleted by the caller),
+      // throws an Exception if the ode is not valid
+      static Function* ode_function(const std::vector<std::string>& variables, const std::string& ode);
+
+    protected:
+
+      std::vector<std::string> m_variables;
+      std::string m_ode;
+      TimePropag m_propagation;
+      Function *m_f;
+      BatchedFunction *m_fv; // derivative tube built in one pass
+      CtcPicard m_ctc_picard;
+      CtcDeriv m_ctc_deriv;
+  };
+}
+
+#endif
@@ -0,0 +1,96 @@
+/** 
+ *  SolutionFile classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cstring>
+#include <sstream>
+#include "tubex_SolutionFile.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  static const char SOLUTIONS_MAGIC[8] = { 'T','B','X','S','O','L','N','S' };
+  static const int SOLUTIONS_VERSION = 1;
+
+  // SolutionWriter
+
+  SolutionWriter::SolutionWriter(const string& file_path)
+    : m_file_path(file_path), m_file(file_path.c_str(), ios::binary | ios::trunc)
+  {
+    BinaryWriter w(m_file);
+    w.write_bytes(SOLUTIONS_MAGIC, sizeof(SOLUTIONS_MAGIC));
+    w.write_int(SOLUTIONS_VERSION);
+    m_file.flush();
+
+    if(m_file.fail())
+      throw Exception(__func__, "unable to create " + file_path);
+  }
+
+  void SolutionWriter::append(const TubeVector& x)
+  {
+    ostringstream o;
+    BinaryWriter w_record(o);
+    w_record.write_tubevector(x);
+    const string record = o.str();
+
+    BinaryWriter w(m_file);
+    w.write_long(record.size());
+    w.write_bytes(record.data(), record.size());
+    m_file.flush();
+
+    if(m_file.fail())
+      throw Exception(__func__, "unable to write in " + m_file_path);
+    m_nb_solutions++;
+  }
+
+  int SolutionWriter::nb_solutions() const
+  {
+    return m_nb_solutions;
+  }
+
+  // SolutionReader
+
+  SolutionReader::SolutionReader(const string& file_path) : m_file(file_path)
+  {
+    BinaryReader r(m_file.data(), m_file.size());
+
+    char magic[sizeof(SOLUTIONS_MAGIC)];
+    if(m_file.size() < sizeof(magic) + sizeof(int))
+      throw Exception(__func__, file_path + " is not a solution file");
+    r.read_bytes(magic, sizeof(magic));
+    if(memcmp(magic, SOLUTIONS_MAGIC, sizeof(magic)) != 0 || r.read_int() != SOLUTIONS_VERSION)
+      throw Exception(__func__, file_path + " is not a solution file");
+
+    // Records are located from their sizes, without being decoded
+    while(m_file.size() - r.offset() >= sizeof(long))
+    {
+      long size = r.read_long();
+      if(size <= 0 || (size_t)size > m_file.size() - r.offset())
+        break; // incomplete last record
+
+      m_records.push_back(make_pair(r.offset(), (size_t)size));
+      r.skip_to(r.offset() + size);
+    }
+  }
+
+  int SolutionReader::size() const
+  {
+    return m_records.size();
+  }
+
+  TubeVector* SolutionReader::tube(int i) const
+  {
+    assert(i >= 0 && i < size());
+    BinaryReader r(m_file.data() + m_records[i].first, m_records[i].second);
+    return r.read_tubevector();
+  }
+}
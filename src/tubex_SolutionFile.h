@@ -0,0 +1,69 @@
+/** 
+ *  SolutionFile classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_SOLUTIONFILE_H__
+#define __TUBEX_SOLUTIONFILE_H__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include "tubex_TubeVector.h"
+#include "tubex_SolverCodec.h"
+
+namespace tubex
+{
+  /**
+   * Binary file of solution tubes: a header, then one record per tube
+   * (size of the record, then the tube encoded as by BinaryWriter: slice
+   * domains, envelopes and gates of each component).
+   *
+   * Records are appended and flushed one by one: a file left by an
+   * interrupted search holds all the tubes written before, an incomplete
+   * last record being ignored by the reader.
+   */
+  class SolutionWriter
+  {
+    public:
+
+      // Creates the file (an existing one is replaced)
+      SolutionWriter(const std::string& file_path);
+      SolutionWriter(const SolutionWriter&) = delete;
+      SolutionWriter& operator=(const SolutionWriter&) = delete;
+
+      void append(const TubeVector& x);
+      int nb_solutions() const;
+
+    protected:
+
+      std::string m_file_path;
+      std::ofstream m_file;
+      int m_nb_solutions = 0;
+  };
+
+  // Memory mapped reading of a solution file: the records are located
+  // when the file is opened, the tubes are decoded only when requested
+  class SolutionReader
+  {
+    public:
+
+      // Throws an Exception if file_path is not a solution file
+      SolutionReader(const std::string& file_path);
+
+      int size() const;
+      TubeVector* tube(int i) const; // to be deleted by the caller
+
+    protected:
+
+      MappedFile m_file;
+      std::vector<std::pair<size_t,size_t> > m_records; // (offset, size) of each tube
+  };
+}
+
+#endif
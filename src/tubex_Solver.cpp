@@ -8,33 +8,83 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
-#include <time.h>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
 #include "tubex_Solver.h"
-
-#define GRAPHICS 1
+#include "tubex_EnvelopeIndex.h"
+#include "tubex_TubeSignature.h"
+#include "tubex_SolverCodec.h"
+#include "tubex_Exception.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace tubex
 {
-  Solver::Solver(const Vector& max_thickness)
+  // Frontier of one thread: the owner works on the back (depth-first),
+  // idle threads steal from the front (nodes closer to the root)
+
+  struct WorkDeque
+  {
+    mutex m;
+    deque<SolverNode*> nodes;
+  };
+
+  // Header of checkpoint files
+
+  static const char CHECKPOINT_MAGIC[8] = { 'T','B','X','S','C','K','P','T' };
+  static const int CHECKPOINT_VERSION = 1;
+
+  // Nodes explored by a worker process before it reports to the parent
+
+  static const int PROCESS_TASK_NB_NODES = 64;
+
+  // Set on SIGINT during an interruptible resolution
+
+  static volatile sig_atomic_t g_sigint = 0;
+
+  static void sigint_handler(int)
+  {
+    g_sigint = 1;
+  }
+
+  Solver::Solver(const Vector& max_thickness, bool graphics)
   {
     m_max_thickness = max_thickness;
+    m_cancel = false;
+    m_strategy = &BisectionStrategy::from_name("first_component");
 
-    #if GRAPHICS // embedded graphics
+    if(graphics) // embedded graphics
+    {
       vibes::beginDrawing();
       m_fig = new VIBesFigTubeVector("Solver");
       m_fig->set_properties(100, 100, 700, 500);
-    #endif
+    }
   }
 
   Solver::~Solver()
   {
-    #if GRAPHICS
+    if(m_fig != NULL)
+    {
+      stop_figure_thread();
       delete m_fig;
       vibes::endDrawing();
-    #endif
+    }
   }
 
   void Solver::set_refining_fxpt_ratio(float refining_fxpt_ratio)
@@ -55,137 +105,1081 @@ namespace tubex
     m_cid_fxpt_ratio = cid_fxpt_ratio;
   }
 
+  void Solver::set_nb_threads(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+    m_nb_threads = nb_threads;
+  }
+
+  void Solver::set_nb_processes(int nb_processes)
+  {
+    assert(nb_processes >= 0);
+    m_nb_processes = nb_processes;
+  }
+
+  void Solver::set_logger(SolverLogger& logger)
+  {
+    m_logger = &logger;
+  }
+
+  SolverLogger& Solver::logger()
+  {
+    return *m_logger;
+  }
+
+  void Solver::set_parallel_cid(bool parallel_cid)
+  {
+    m_parallel_cid = parallel_cid;
+  }
+
+  void Solver::set_cid_splits(int nb_splits)
+  {
+    assert(nb_splits >= 2);
+    m_cid_nb_splits = nb_splits;
+  }
+
+  void Solver::set_cid_nb_times(int nb_times)
+  {
+    assert(nb_times > 0);
+    m_cid_nb_times = nb_times;
+  }
+
+  void Solver::set_cid_shaving(bool shaving)
+  {
+    m_cid_shaving = shaving;
+  }
+
+  void Solver::set_max_refining_batch(int max_batch)
+  {
+    assert(max_batch > 0);
+    m_max_refining_batch = max_batch;
+  }
+
+  void Solver::set_clustering_ratio(float clustering_ratio)
+  {
+    assert(clustering_ratio >= 0. && clustering_ratio <= 1.);
+    m_clustering_ratio = clustering_ratio;
+  }
+
+  void Solver::set_max_solutions(int max_solutions)
+  {
+    assert(max_solutions >= 0);
+    m_max_solutions = max_solutions;
+  }
+
+  void Solver::set_solution_callback(const SolutionCallback& callback)
+  {
+    m_solution_callback = callback;
+  }
+
+  void Solver::set_time_limit(double time_limit)
+  {
+    assert(time_limit >= 0.);
+    m_time_limit = time_limit;
+  }
+
+  void Solver::set_max_nodes(int max_nodes)
+  {
+    assert(max_nodes >= 0);
+    m_max_nodes = max_nodes;
+  }
+
+  void Solver::set_interruptible(bool interruptible)
+  {
+    m_interruptible = interruptible;
+  }
+
+  void Solver::cancel()
+  {
+    m_cancel = true;
+  }
+
+  void Solver::set_bisection_strategy(const BisectionStrategy& strategy)
+  {
+    m_strategy = &strategy;
+  }
+
+  void Solver::set_checkpoint(const string& file_path, double period)
+  {
+    assert(period >= 0.);
+    m_checkpoint_path = file_path;
+    m_checkpoint_period = period;
+  }
+
+  void Solver::set_solution_file(const string& file_path)
+  {
+    m_solution_file_path = file_path;
+  }
+
   const list<TubeVector> Solver::solve(const TubeVector& x0, void (*ctc_func)(TubeVector&))
   {
-    assert(x0.size() == m_max_thickness.size());
+    SolverCtcFunc ctc(ctc_func);
+    return solve(x0, ctc);
+  }
 
-    int i = 0;
-    clock_t t_start = clock();
+  const list<TubeVector> Solver::solve(const TubeVector& x0, SolverContractor& ctc)
+  {
+    assert(x0.size() == m_max_thickness.size());
 
-    #if GRAPHICS
-      m_fig->show(true);
-    #endif
+    deque<SolverNode*> frontier;
+    frontier.push_back(new SolverNode(x0));
+    list<TubeVector> l_solutions;
+    search(frontier, l_solutions, ctc);
+    return l_solutions;
+  }
 
-    int prev_level = 0;
-    list<pair<int,TubeVector> > s;
-    s.push_back(make_pair(0, x0));
+  const list<TubeVector> Solver::resume(const string& file_path, SolverContractor& ctc)
+  {
+    deque<SolverNode*> frontier;
     list<TubeVector> l_solutions;
+    load_checkpoint(file_path, frontier, l_solutions);
+    search(frontier, l_solutions, ctc);
+    return l_solutions;
+  }
 
-    while(!s.empty())
+  void Solver::search(deque<SolverNode*>& frontier, list<TubeVector>& l_solutions, SolverContractor& ctc)
+  {
+    SolverChrono timer_total, timer_phase, timer_checkpoint;
+    m_stats.reset();
+    m_stats.strategy = m_strategy->name();
+    int nb_recycled = m_pool.nb_recycled();
+    m_undecided.clear();
+    m_cancel = false;
+    m_fig_nb_solutions = 0;
+
+    // The SIGINT handler, the solution file and the nodes left in the
+    // frontier and the CID clones and threads are also released if the
+    // search ends by an exception
+    struct SearchCleanup
     {
-      int level = s.front().first;
-      if(level != prev_level && s.size() >= 8)
+      bool interruptible;
+      void (*prev_sigint_handler)(int);
+      SolutionWriter *&solution_writer;
+      deque<SolverNode*>& frontier;
+      map<const SolverContractor*,vector<SolverContractor*> >& cid_clones;
+      ThreadPool *&cid_threads;
+
+      ~SearchCleanup()
       {
-        cout << "clustering (" << s.size() << " items)" << endl;
-        //clustering(s);
-        prev_level = level;
+        if(interruptible)
+          signal(SIGINT, prev_sigint_handler);
+        delete solution_writer;
+        solution_writer = NULL;
+        for(size_t k = 0 ; k < frontier.size() ; k++) // empty after a normal end
+          delete frontier[k];
+        frontier.clear();
+        for(auto it = cid_clones.begin() ; it != cid_clones.end() ; ++it)
+          for(size_t k = 0 ; k < it->second.size() ; k++)
+            delete it->second[k];
+        cid_clones.clear();
+        delete cid_threads;
+        cid_threads = NULL;
       }
+    } cleanup = { m_interruptible, SIG_DFL, m_solution_writer, frontier, m_cid_clones, m_cid_threads };
+
+    if(m_interruptible)
+    {
+      g_sigint = 0;
+      cleanup.prev_sigint_handler = signal(SIGINT, sigint_handler);
+    }
+
+    if(!m_solution_file_path.empty())
+      m_solution_writer = new SolutionWriter(m_solution_file_path);
+
+    size_t nb_prev_solutions = l_solutions.size(); // resumed search
+    for(list<TubeVector>::iterator it = l_solutions.begin() ; it != l_solutions.end() ; ++it)
+    {
+      add_figure_solution(&(*it));
+      if(m_solution_writer != NULL)
+        m_solution_writer->append(*it);
+    }
 
-      TubeVector x = s.front().second;
-      s.pop_front();
+    // 0: as many threads or processes as hardware cores
+    int nb_threads = m_nb_threads == 0 ? (int)thread::hardware_concurrency() : m_nb_threads;
+    int nb_processes = m_nb_processes == 0 ? (int)thread::hardware_concurrency() : m_nb_processes;
 
-      bool emptiness;
-      double volume_before_refining;
-      
-      do
+    // Worker processes are forked before the figure thread is started:
+    // a lock held by another thread would remain locked in the children
+    if(nb_processes <= 1)
+      start_figure_thread();
+
+    if(nb_processes > 1 || nb_threads > 1)
+    {
+      if(nb_processes > 1)
       {
-        volume_before_refining = x.volume();
+        solve_processes(frontier, ctc, l_solutions, nb_processes);
+        start_figure_thread();
+      }
 
-        // 1. Refining
+      else
+        solve_parallel(frontier, ctc, l_solutions, nb_threads);
 
-          if(m_refining_fxpt_ratio != 0.)
-          {
-            double t_refining = x[0].wider_slice()->domain().mid();
-            x.sample(t_refining);
-          }
+      // Displaying solutions, in the same order as the serial search
+      list<TubeVector>::iterator it = l_solutions.begin();
+      advance(it, nb_prev_solutions);
+      for( ; it != l_solutions.end() ; ++it)
+        add_figure_solution(&(*it));
+    }
+
+    else
+    {
+      if(m_parallel_cid && m_cid_fxpt_ratio != 0.)
+      {
+        prepare_cid_clones(ctc);
+        m_cid_threads = new ThreadPool(m_cid_nb_splits - 1); // one per concurrent CID branch
+      }
+
+      int prev_level = 0;
+      bool search_stopped = false;
+      TubeSummary summary; // buffers reused from one node to the other
+      deque<SolverNode*>& s = frontier;
+
+      while(!s.empty() && !search_stopped)
+      {
+        if(budget_exhausted(timer_total.elapsed(), m_stats.nb_nodes))
+          break;
+
+        if(!m_checkpoint_path.empty() && timer_checkpoint.elapsed() >= m_checkpoint_period)
+        {
+          save_checkpoint(s, l_solutions);
+          timer_checkpoint.restart();
+        }
+
+        int level = s.front()->level();
+        if(m_clustering_ratio != 0. && level != prev_level && s.size() >= 8)
+        {
+          clustering(s, m_stats);
+          prev_level = level;
+        }
 
-        // 2. Propagations up to the fixed point
+        m_stats.max_frontier_size = std::max(m_stats.max_frontier_size, (int)s.size());
+        SolverNode *node = s.front();
+        s.pop_front();
+        TubeVector *x = node_tube(*node, m_stats, m_pool);
+        m_stats.nb_nodes++;
 
-          propagation(x, ctc_func, m_propa_fxpt_ratio);
+        // 1, 2, 3: refining, propagations and CID
 
-        // 3. CID up to the fixed point
+          bool emptiness = !contract_node(*x, ctc, m_stats, summary, m_pool);
+          if(emptiness)
+            m_stats.nb_empty_prunes++;
+
+        // 4. Bisection
 
-          emptiness = x.is_empty();
           if(!emptiness)
           {
-            cid(x, ctc_func);
-            emptiness = x.is_empty();
+            if(stopping_condition_met(summary.max_diam()))
+            {
+              l_solutions.push_back(*x); // TubeVector cannot be moved
+              count_copy(*x, m_stats);
+              add_figure_solution(&l_solutions.back());
+              search_stopped = !deliver_solution(*x, l_solutions.size());
+            }
+
+            else
+            {
+              if(m_logger->enabled(SolverLogger::NODES))
+                m_logger->message(SolverLogger::NODES, "Bisection... (level " + to_string(level) + ")");
+              timer_phase.restart();
+              double t_bisection = m_strategy->bisection_time(*x, m_max_thickness);
+              int i_bisection = m_strategy->bisection_component((*x)(t_bisection), m_max_thickness);
+              pair<SolverNode*,SolverNode*> p_nodes = SolverNode::bisect(*node, x, t_bisection, i_bisection);
+              x = NULL; // now shared by the two children
+              s.push_back(p_nodes.first);
+              s.push_back(p_nodes.second);
+              m_stats.nb_bisections++;
+              m_stats.t_bisection += timer_phase.elapsed();
+            }
           }
-          
-      } while(!emptiness
-           && !stopping_condition_met(x)
-           && !fixed_point_reached(volume_before_refining, x.volume(), m_refining_fxpt_ratio));
 
-      // 4. Bisection
+          m_pool.release(x);
+          delete node;
+
+        m_logger->progress(l_solutions.size(), timer_total.elapsed());
+      }
+    }
+
+    if(!m_checkpoint_path.empty()) // final state, possibly left by a stop
+      save_checkpoint(frontier, l_solutions);
+    set_undecided(frontier);
+    m_stats.nb_recycled_tubes += m_pool.nb_recycled() - nb_recycled;
+
+    stop_figure_thread();
+    m_stats.nb_solutions = l_solutions.size();
+    m_stats.t_total = timer_total.elapsed();
+    m_logger->progress(l_solutions.size(), m_stats.t_total, true);
+
+    if(m_logger->enabled(SolverLogger::SUMMARY))
+    {
+      ostringstream o_time, o_stats;
+      o_time << "Time taken: " << fixed << setprecision(2) << m_stats.t_total << "s";
+      o_stats << m_stats;
+      m_logger->message(SolverLogger::SUMMARY, o_time.str());
+      m_logger->message(SolverLogger::SUMMARY, o_stats.str());
+    }
+
+    if(m_logger->enabled(SolverLogger::SOLUTIONS))
+    {
+      int j = 0;
+      list<TubeVector>::iterator it;
+      for(it = l_solutions.begin(); it != l_solutions.end(); ++it)
+      {
+        j++;
+        ostringstream o;
+        o << "  " << j << ": "
+          << *it <<  ", tf↦" << (*it)(it->domain().ub())
+          << " (max thickness: " << it->max_diam() << ")";
+        m_logger->message(SolverLogger::SOLUTIONS, o.str());
+      }
+    }
+
+    m_logger->flush();
+  }
+
+  void Solver::save_checkpoint(const deque<SolverNode*>& frontier, const list<TubeVector>& l_solutions)
+  {
+    // Written in a temporary file first: a crash while writing
+    // does not lose the previous checkpoint
+    string tmp_path = m_checkpoint_path + ".tmp";
+    ofstream f(tmp_path.c_str(), ios::binary | ios::trunc);
+    if(!f.is_open())
+      throw Exception(__func__, "unable to write checkpoint in " + tmp_path);
+
+    BinaryWriter w(f);
+    w.write_bytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    w.write_int(CHECKPOINT_VERSION);
+    w.write_vector(m_max_thickness);
+    w.write_double(m_refining_fxpt_ratio);
+    w.write_double(m_propa_fxpt_ratio);
+    w.write_double(m_cid_fxpt_ratio);
+
+    w.write_int(l_solutions.size());
+    for(list<TubeVector>::const_iterator it = l_solutions.begin() ; it != l_solutions.end() ; ++it)
+      w.write_tubevector(*it);
+    SolverNode::write_nodes(w, frontier);
+
+    f.close();
+    if(f.fail() || rename(tmp_path.c_str(), m_checkpoint_path.c_str()) != 0)
+      throw Exception(__func__, "unable to write checkpoint in " + m_checkpoint_path);
+  }
+
+  void Solver::load_checkpoint(const string& file_path, deque<SolverNode*>& frontier, list<TubeVector>& l_solutions)
+  {
+    MappedFile file(file_path);
+    BinaryReader r(file.data(), file.size());
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    r.read_bytes(magic, sizeof(magic));
+    if(memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0 || r.read_int() != CHECKPOINT_VERSION)
+      throw Exception(__func__, file_path + " is not a solver checkpoint");
+
+    m_max_thickness = r.read_vector();
+    m_refining_fxpt_ratio = r.read_double();
+    m_propa_fxpt_ratio = r.read_double();
+    m_cid_fxpt_ratio = r.read_double();
+
+    int nb_solutions = r.read_int();
+    for(int k = 0 ; k < nb_solutions ; k++)
+    {
+      TubeVector *x = r.read_tubevector();
+      l_solutions.push_back(*x); // TubeVector cannot be moved
+      delete x;
+    }
+    SolverNode::read_nodes(r, frontier);
+  }
+
+  TubeVector* Solver::node_tube(SolverNode& node, SolverStats& stats, TubePool& pool)
+  {
+    bool copied;
+    TubeVector *x = node.tube(pool, copied);
+    if(copied)
+      count_copy(*x, stats);
+    return x;
+  }
+
+  void Solver::count_copy(const TubeVector& x, SolverStats& stats)
+  {
+    stats.nb_tube_copies++;
+    stats.nb_slice_copies += (long)x.size() * x.nb_slices();
+  }
+
+  bool Solver::contract_node(TubeVector& x, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool)
+  {
+    bool emptiness;
+    double volume_before_refining, volume_after_refining;
+    int refining_batch = 1;
+    double prev_gain_per_sample = 0.;
+    vector<double> v_t_refining;
+    SolverChrono timer;
+    summary.reset(x);
+    
+    do
+    {
+      volume_before_refining = summary.volume();
+      stats.nb_refining_iterations++;
+
+      // 1. Refining
+
+        timer.restart();
+        if(m_refining_fxpt_ratio != 0.)
+        {
+          m_strategy->refining_times(x, m_max_thickness, refining_batch, v_t_refining);
+          for(size_t k = 0 ; k < v_t_refining.size() ; k++)
+            x.sample(v_t_refining[k]);
+          stats.nb_refining_samples += v_t_refining.size();
+          summary.update(x);
+        }
+        stats.t_refining += timer.elapsed();
+
+      // 2. Propagations up to the fixed point
+
+        timer.restart();
+        stats.nb_propa_ctc_calls += propagation(x, ctc, m_propa_fxpt_ratio, summary);
+        emptiness = summary.is_empty();
+        double volume_after_propa = emptiness ? 0. : summary.volume();
+        if(std::isfinite(volume_before_refining) && std::isfinite(volume_after_propa))
+          stats.propa_volume_reduction += volume_before_refining - volume_after_propa;
+        stats.t_propagation += timer.elapsed();
+
+      // 3. CID up to the fixed point
 
         if(!emptiness)
         {
-          if(stopping_condition_met(x))
+          timer.restart();
+          cid(x, ctc, stats, summary, pool);
+          emptiness = summary.is_empty();
+          double volume_after_cid = emptiness ? 0. : summary.volume();
+          if(std::isfinite(volume_after_propa) && std::isfinite(volume_after_cid)) // no reduction from an unbounded tube
+            stats.cid_volume_reduction += volume_after_propa - volume_after_cid;
+          stats.t_cid += timer.elapsed();
+        }
+
+        volume_after_refining = emptiness ? 0. : summary.volume();
+
+      // Size of the next batch: doubled while the contraction
+      // gained by each sample holds, halved when it drops
+
+        if(m_max_refining_batch > 1 && !emptiness && volume_before_refining > 0.)
+        {
+          double ratio = std::pow(volume_after_refining / volume_before_refining, 1. / m_max_thickness.size());
+          double gain_per_sample = (1. - ratio) / refining_batch;
+          if(gain_per_sample >= 0.5 * prev_gain_per_sample)
+            refining_batch = std::min(2 * refining_batch, m_max_refining_batch);
+          else
+            refining_batch = std::max(1, refining_batch / 2);
+          prev_gain_per_sample = gain_per_sample;
+        }
+        
+    } while(!emptiness
+         && !stopping_condition_met(summary.max_diam())
+         && !fixed_point_reached(volume_before_refining, volume_after_refining, m_refining_fxpt_ratio));
+
+    return !emptiness;
+  }
+
+  bool Solver::budget_exhausted(double elapsed_time, int nb_nodes) const
+  {
+    return m_cancel || (m_interruptible && g_sigint)
+        || (m_time_limit != 0. && elapsed_time >= m_time_limit)
+        || (m_max_nodes != 0 && nb_nodes >= m_max_nodes);
+  }
+
+  void Solver::set_undecided(deque<SolverNode*>& frontier)
+  {
+    for(size_t k = 0 ; k < frontier.size() ; k++)
+    {
+      TubeVector *x = node_tube(*frontier[k], m_stats, m_pool);
+      m_undecided.push_back(*x); // TubeVector cannot be moved
+      count_copy(*x, m_stats);
+      m_pool.release(x);
+      delete frontier[k];
+    }
+
+    frontier.clear();
+    m_stats.nb_undecided = m_undecided.size();
+  }
+
+  bool Solver::deliver_solution(const TubeVector& x, int nb_solutions)
+  {
+    if(m_solution_writer != NULL)
+      m_solution_writer->append(x);
+    if(m_solution_callback && !m_solution_callback(x))
+      return false;
+    return m_max_solutions == 0 || nb_solutions < m_max_solutions;
+  }
+
+  void Solver::solve_parallel(deque<SolverNode*>& frontier, SolverContractor& ctc, list<TubeVector>& l_solutions, int nb_threads)
+  {
+    assert(nb_threads > 1);
+
+    // Each thread contracts with its own instance; the clones are built
+    // here, sequentially, as their setup may not be thread-safe
+    vector<SolverContractor*> v_ctc(1, &ctc);
+    for(int k = 1 ; k < nb_threads ; k++)
+      v_ctc.push_back(ctc.clone());
+
+    vector<WorkDeque> v_deques(nb_threads);
+    vector<pair<SolverNode*,TubeVector*> > v_solutions;
+    vector<SolverStats> v_stats(nb_threads);
+    mutex solutions_mutex;
+    SolverChrono timer_total;
+
+    // Number of nodes pushed in a deque and not fully processed yet:
+    // the search is over when it reaches 0, or when stopped
+    atomic<int> nb_pending(frontier.size());
+    atomic<bool> search_stopped(false);
+    // Stop requested by max_solutions or by the callback: the next
+    // solutions are dropped. After a budget stop, they are still kept
+    // (otherwise they would be neither solutions nor undecided)
+    atomic<bool> solutions_stopped(false);
+    atomic<int> nb_nodes(0); // nodes taken from the deques
+    exception_ptr worker_error; // first exception thrown in a thread
+    for(size_t k = 0 ; k < frontier.size() ; k++)
+      v_deques[k % nb_threads].nodes.push_back(frontier[k]);
+    frontier.clear();
+
+    auto worker = [&](int id)
+    {
+      WorkDeque& own = v_deques[id];
+      SolverStats& stats = v_stats[id];
+      TubeSummary summary;
+      TubePool pool;
+      SolverChrono timer;
+
+      while(nb_pending > 0 && !search_stopped)
+      {
+        if(budget_exhausted(timer_total.elapsed(), nb_nodes))
+        {
+          search_stopped = true;
+          break;
+        }
+
+        SolverNode *node = NULL;
+
+        {
+          lock_guard<mutex> lock(own.m);
+          if(!own.nodes.empty())
           {
-            l_solutions.push_back(x);
-
-            #if GRAPHICS // displaying solution
-              i++;
-              ostringstream o; o << "solution_" << i;
-              m_fig->add_tubevector(&l_solutions.back(), o.str());
-              m_fig->show(true);
-            #endif
+            node = own.nodes.back();
+            own.nodes.pop_back();
           }
+        }
+
+        for(int k = 1 ; node == NULL && k < nb_threads ; k++) // work stealing
+        {
+          WorkDeque& other = v_deques[(id + k) % nb_threads];
+          lock_guard<mutex> lock(other.m);
+          if(!other.nodes.empty())
+          {
+            node = other.nodes.front();
+            other.nodes.pop_front();
+          }
+        }
+
+        if(node == NULL)
+        {
+          this_thread::yield();
+          continue;
+        }
+
+        // An exception (contractor, tubex, delivery of a solution) cannot
+        // leave the thread: the first one stops the search, and is
+        // rethrown once the threads are joined
+        TubeVector *x = NULL;
+        try
+        {
+          x = node_tube(*node, stats, pool);
+          stats.nb_nodes++;
+          nb_nodes++;
+          if(!contract_node(*x, *v_ctc[id], stats, summary, pool))
+            stats.nb_empty_prunes++;
 
           else
           {
-            cout << "Bisection... (level " << level << ")" << endl;
-            double t_bisection = x[0].largest_slice()->domain().mid();
-            pair<TubeVector,TubeVector> p_x = x.bisect(t_bisection);
-            level++; // deeper
-            s.push_back(make_pair(level, p_x.first));
-            s.push_back(make_pair(level, p_x.second));
+            if(stopping_condition_met(summary.max_diam()))
+            {
+              lock_guard<mutex> lock(solutions_mutex);
+              if(!solutions_stopped)
+              {
+                v_solutions.push_back(make_pair(node, x));
+                node = NULL; x = NULL; // kept as a solution
+                if(!deliver_solution(*v_solutions.back().second, v_solutions.size()))
+                  solutions_stopped = search_stopped = true;
+              }
+            }
+
+            else
+            {
+              if(m_logger->enabled(SolverLogger::NODES))
+                m_logger->message(SolverLogger::NODES, "Bisection... (level " + to_string(node->level()) + ")");
+
+              timer.restart();
+              double t_bisection = m_strategy->bisection_time(*x, m_max_thickness);
+              int i_bisection = m_strategy->bisection_component((*x)(t_bisection), m_max_thickness);
+              pair<SolverNode*,SolverNode*> p_nodes = SolverNode::bisect(*node, x, t_bisection, i_bisection);
+              x = NULL; // now shared by the two children
+              SolverNode *first = p_nodes.first, *second = p_nodes.second;
+
+              stats.max_frontier_size = std::max(stats.max_frontier_size, (int)(nb_pending += 2));
+              stats.nb_bisections++;
+              stats.t_bisection += timer.elapsed();
+              lock_guard<mutex> lock(own.m);
+              own.nodes.push_back(first);
+              own.nodes.push_back(second);
+            }
+          }
+
+          if(m_logger->enabled(SolverLogger::PROGRESS))
+          {
+            size_t nb_solutions;
+            {
+              lock_guard<mutex> lock(solutions_mutex);
+              nb_solutions = v_solutions.size();
+            }
+            m_logger->progress(nb_solutions, timer_total.elapsed());
+          }
+        }
+
+        catch(...)
+        {
+          lock_guard<mutex> lock(solutions_mutex);
+          if(!worker_error)
+            worker_error = current_exception();
+          solutions_stopped = search_stopped = true;
+        }
+
+        pool.release(x);
+        delete node;
+        nb_pending--;
+      }
+
+      stats.nb_recycled_tubes = pool.nb_recycled();
+    };
+
+    vector<thread> v_threads;
+    for(int k = 0 ; k < nb_threads ; k++)
+      v_threads.push_back(thread(worker, k));
+    for(int k = 0 ; k < nb_threads ; k++)
+      v_threads[k].join();
+    for(int k = 0 ; k < nb_threads ; k++) // left by a stop
+      frontier.insert(frontier.end(), v_deques[k].nodes.begin(), v_deques[k].nodes.end());
+    sort(frontier.begin(), frontier.end(), SolverNode::bfs_order);
+    for(int k = 1 ; k < nb_threads ; k++)
+      delete v_ctc[k];
+    for(int k = 0 ; k < nb_threads ; k++)
+      m_stats += v_stats[k];
+
+    // Solutions are returned in the order of the serial search,
+    // whatever the scheduling of the threads
+    sort(v_solutions.begin(), v_solutions.end(),
+      [](const pair<SolverNode*,TubeVector*>& s1, const pair<SolverNode*,TubeVector*>& s2)
+        { return SolverNode::bfs_order(s1.first, s2.first); });
+    for(size_t k = 0 ; k < v_solutions.size() ; k++)
+    {
+      l_solutions.push_back(*v_solutions[k].second);
+      count_copy(*v_solutions[k].second, m_stats);
+      delete v_solutions[k].first;
+      delete v_solutions[k].second;
+    }
+
+    if(worker_error)
+      rethrow_exception(worker_error);
+  }
+
+  void Solver::solve_processes(deque<SolverNode*>& frontier, SolverContractor& ctc, list<TubeVector>& l_solutions, int nb_processes)
+  {
+    assert(nb_processes > 1);
+
+    struct Worker
+    {
+      pid_t pid;
+      int fd; // socket to the worker, -1 once terminated
+      string task; // nodes being explored by the worker
+    };
+
+    // Workers and solution nodes held by the parent, released on every
+    // exit: if the search ends by an exception (delivery of a solution,
+    // no worker left, poll), the workers are killed instead of being
+    // left blocked on their sockets
+    struct Workers
+    {
+      vector<Worker> v;
+      deque<SolverNode*> solutions; // received, not returned yet
+      bool interrupted = true; // until the normal end of the search
+
+      ~Workers()
+      {
+        for(size_t k = 0 ; k < v.size() ; k++)
+        {
+          if(v[k].fd != -1)
+            close(v[k].fd); // end of the worker loop
+          if(interrupted)
+            kill(v[k].pid, SIGKILL);
+          waitpid(v[k].pid, NULL, 0);
+        }
+
+        for(size_t k = 0 ; k < solutions.size() ; k++)
+          delete solutions[k];
+      }
+    } workers;
+
+    vector<Worker>& v_workers = workers.v;
+    m_logger->flush(); // buffered outputs would be written by each child
+
+    for(int k = 0 ; k < nb_processes ; k++)
+    {
+      int fds[2];
+      if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+        throw Exception(__func__, "unable to create worker sockets");
+
+      pid_t pid = fork();
+      if(pid == -1)
+      {
+        close(fds[0]);
+        close(fds[1]);
+        throw Exception(__func__, "unable to fork a worker process");
+      }
+
+      if(pid == 0) // worker: the process only explores the nodes it receives
+      {
+        close(fds[0]);
+        for(size_t i = 0 ; i < v_workers.size() ; i++)
+          close(v_workers[i].fd);
+
+        // The stack of the parent must not be unwound in the child
+        // (the guard above would kill the other workers)
+        int status = EXIT_SUCCESS;
+        try
+        {
+          process_worker(fds[1], ctc);
+        }
+
+        catch(...)
+        {
+          status = EXIT_FAILURE; // seen by the parent as a terminated worker
+        }
+
+        _exit(status); // no destructor of the parent objects
+      }
+
+      close(fds[1]);
+      Worker w;
+      w.pid = pid;
+      w.fd = fds[0];
+      v_workers.push_back(w);
+    }
+
+    // A terminated worker (crash, memory exhaustion...) is not given
+    // tasks anymore; the search fails if no worker is left
+    auto worker_terminated = [&](Worker& w)
+    {
+      close(w.fd);
+      w.fd = -1;
+      w.task.clear();
+
+      bool all_terminated = true;
+      for(size_t i = 0 ; i < v_workers.size() ; i++)
+        all_terminated &= v_workers[i].fd == -1;
+      if(all_terminated)
+        throw Exception(__func__, "all the worker processes terminated");
+    };
+
+    SolverChrono timer_total;
+    deque<SolverNode*>& v_solutions = workers.solutions;
+    bool search_stopped = false;
+    bool solutions_stopped = false; // by max_solutions or the callback, see solve_parallel()
+
+    while(true)
+    {
+      search_stopped |= budget_exhausted(timer_total.elapsed(), m_stats.nb_nodes);
+
+      // Idle workers get the next nodes of the frontier (one subtree each)
+      int nb_busy = 0;
+      for(size_t k = 0 ; k < v_workers.size() ; k++)
+      {
+        Worker& w = v_workers[k];
+        if(w.fd != -1 && w.task.empty() && !search_stopped && !frontier.empty())
+        {
+          deque<SolverNode*> task(1, frontier.front());
+          frontier.pop_front();
+          ostringstream o;
+          BinaryWriter writer(o);
+          SolverNode::write_nodes(writer, task);
+          w.task = o.str();
+
+          if(write_message(w.fd, w.task))
+            delete task[0];
+
+          else // the node goes back to the frontier
+          {
+            frontier.push_front(task[0]);
+            worker_terminated(w);
           }
         }
 
-      cout << "\rSolutions: " << l_solutions.size() << "  (" << (int)((double)(clock() - t_start)/CLOCKS_PER_SEC) << "s)   " << flush;
+        nb_busy += !w.task.empty();
+      }
+
+      if(nb_busy == 0)
+      {
+        if(search_stopped || frontier.empty())
+          break;
+        continue; // node given back by a terminated worker, to be dispatched again
+      }
+
+      vector<pollfd> v_pollfds;
+      for(size_t k = 0 ; k < v_workers.size() ; k++)
+        if(!v_workers[k].task.empty())
+          v_pollfds.push_back({ v_workers[k].fd, POLLIN, 0 });
+      if(poll(v_pollfds.data(), v_pollfds.size(), -1) == -1 && errno != EINTR)
+        throw Exception(__func__, "unable to wait for the worker processes");
+
+      for(size_t k = 0 ; k < v_workers.size() ; k++)
+      {
+        Worker& w = v_workers[k];
+        bool readable = false;
+        for(size_t i = 0 ; i < v_pollfds.size() ; i++)
+          readable |= v_pollfds[i].fd == w.fd && v_pollfds[i].revents != 0;
+        if(!readable)
+          continue;
+
+        string result;
+        if(!read_message(w.fd, result))
+        {
+          // The worker terminated: its task goes
+          // back to the frontier, for the other workers
+          BinaryReader r(w.task.data(), w.task.size());
+          SolverNode::read_nodes(r, frontier);
+          worker_terminated(w);
+          continue;
+        }
+
+        BinaryReader r(result.data(), result.size());
+        SolverStats worker_stats;
+        worker_stats.read(r);
+        m_stats += worker_stats;
+
+        // Solutions are held by the guard before being delivered
+        size_t i = v_solutions.size();
+        SolverNode::read_nodes(r, v_solutions);
+        for( ; i < v_solutions.size() && !solutions_stopped ; i++)
+        {
+          bool copied;
+          TubeVector *x = v_solutions[i]->tube(m_pool, copied);
+          v_solutions[i]->set_tube(x);
+          if(!deliver_solution(*x, l_solutions.size() + i + 1))
+            solutions_stopped = search_stopped = true;
+        }
+
+        while(v_solutions.size() > i) // received after a stop
+        {
+          delete v_solutions.back();
+          v_solutions.pop_back();
+        }
+
+        SolverNode::read_nodes(r, frontier); // rest of the subtree
+        m_stats.max_frontier_size = std::max(m_stats.max_frontier_size, (int)frontier.size());
+        w.task.clear();
+      }
+
+      m_logger->progress(l_solutions.size() + v_solutions.size(), timer_total.elapsed());
     }
 
-    cout << endl;
-    printf("Time taken: %.2fs\n", (double)(clock() - t_start)/CLOCKS_PER_SEC);
+    workers.interrupted = false; // idle workers, ended by closing their sockets
 
-    int j = 0;
-    list<TubeVector>::iterator it;
-    for(it = l_solutions.begin(); it != l_solutions.end(); ++it)
+    // Solutions are returned in the order of the serial search,
+    // whatever the scheduling of the processes
+    sort(v_solutions.begin(), v_solutions.end(), SolverNode::bfs_order);
+    while(!v_solutions.empty())
     {
-      j++;
-      cout << "  " << j << ": "
-           << *it <<  ", tf↦" << (*it)(it->domain().ub())
-           << " (max thickness: " << it->max_diam() << ")"
-           << endl;
+      bool copied;
+      TubeVector *x = v_solutions.front()->tube(m_pool, copied);
+      l_solutions.push_back(*x); // TubeVector cannot be moved
+      count_copy(*x, m_stats);
+      m_pool.release(x);
+      delete v_solutions.front();
+      v_solutions.pop_front();
     }
 
-    return l_solutions;
+    sort(frontier.begin(), frontier.end(), SolverNode::bfs_order);
   }
 
-  void Solver::clustering(list<pair<int,TubeVector> >& l_tubes)
+  void Solver::process_worker(int fd, SolverContractor& ctc)
   {
-    assert(!l_tubes.empty());
+    TubeSummary summary;
+    TubePool pool;
+    string task;
 
-    list<pair<int,TubeVector> > l_clustered;
-    list<pair<int,TubeVector> >::iterator it1, it2;
-    for(it1 = l_tubes.begin(); it1 != l_tubes.end(); ++it1)
+    while(read_message(fd, task))
     {
-      bool clustering = false;
-      for(it2 = l_clustered.begin(); it2 != l_clustered.end(); ++it2)
+      // The subtree of the received node is explored depth-first,
+      // up to a number of nodes: the rest is sent back to the parent
+      // with the solutions, to be shared with the other workers
+      BinaryReader r(task.data(), task.size());
+      deque<SolverNode*> nodes, solutions;
+      SolverNode::read_nodes(r, nodes);
+      SolverStats stats;
+      int nb_recycled = pool.nb_recycled();
+
+      for(int k = 0 ; k < PROCESS_TASK_NB_NODES && !nodes.empty() ; k++)
       {
-        if(it1->second.overlaps(it2->second, 0.9))
+        SolverNode *node = nodes.back();
+        nodes.pop_back();
+        TubeVector *x = node_tube(*node, stats, pool);
+        stats.nb_nodes++;
+
+        if(!contract_node(*x, ctc, stats, summary, pool))
+          stats.nb_empty_prunes++;
+
+        else if(stopping_condition_met(summary.max_diam()))
         {
-          it2->second = it2->second | it1->second;
-          clustering = true;
+          node->set_tube(x);
+          solutions.push_back(node);
+          node = NULL; x = NULL; // sent as a solution
         }
+
+        else
+        {
+          SolverChrono timer;
+          double t_bisection = m_strategy->bisection_time(*x, m_max_thickness);
+          int i_bisection = m_strategy->bisection_component((*x)(t_bisection), m_max_thickness);
+          pair<SolverNode*,SolverNode*> p_nodes = SolverNode::bisect(*node, x, t_bisection, i_bisection);
+          x = NULL; // now shared by the two children
+          nodes.push_back(p_nodes.second);
+          nodes.push_back(p_nodes.first);
+          stats.nb_bisections++;
+          stats.t_bisection += timer.elapsed();
+        }
+
+        pool.release(x);
+        delete node;
       }
 
-      if(!clustering)
-        l_clustered.push_back(*it1);
+      stats.nb_recycled_tubes = pool.nb_recycled() - nb_recycled;
+      ostringstream o;
+      BinaryWriter w(o);
+      stats.write(w);
+      SolverNode::write_nodes(w, solutions);
+      SolverNode::write_nodes(w, nodes);
+      for(size_t k = 0 ; k < solutions.size() ; k++)
+        delete solutions[k];
+      for(size_t k = 0 ; k < nodes.size() ; k++)
+        delete nodes[k];
+
+      if(!write_message(fd, o.str()))
+        break;
     }
 
-    l_tubes = l_clustered;
+    close(fd);
+  }
+
+  void Solver::clustering(deque<SolverNode*>& frontier, SolverStats& stats)
+  {
+    assert(!frontier.empty());
+
+    // The tubes of the frontier are built to be compared. Their signatures
+    // (envelopes over time chunks) give the overlap candidates: for each
+    // chunk, the envelopes of the first component are indexed, and a
+    // candidate must intersect in nb_required chunks (see TubeSignature)
+    const int nb_chunks = 16;
+    int nb_required = TubeSignature::nb_required_chunks(nb_chunks, m_clustering_ratio);
+    vector<TubeVector*> v_x(frontier.size());
+    vector<TubeSignature> v_signatures;
+    vector<Interval> v_ranges(nb_chunks, Interval::EMPTY_SET);
+    for(size_t k = 0 ; k < frontier.size() ; k++)
+    {
+      v_x[k] = node_tube(*frontier[k], stats, m_pool);
+      v_signatures.push_back(TubeSignature(*v_x[k], nb_chunks));
+      for(int j = 0 ; j < nb_chunks ; j++)
+        if(!v_signatures.back().chunk(j)[0].is_unbounded())
+          v_ranges[j] |= v_signatures.back().chunk(j)[0];
+    }
+
+    vector<EnvelopeIndex> v_indexes;
+    for(int j = 0 ; j < nb_chunks ; j++)
+      v_indexes.push_back(EnvelopeIndex(v_ranges[j], frontier.size()));
+
+    auto insert = [&](int k)
+    {
+      for(int j = 0 ; j < nb_chunks ; j++)
+        v_indexes[j].insert(k, IntervalVector(1, v_signatures[k].chunk(j)[0]));
+    };
+
+    auto remove = [&](int k)
+    {
+      for(int j = 0 ; j < nb_chunks ; j++)
+        v_indexes[j].remove(k);
+    };
+
+    vector<int> v_ids, v_touched, v_candidates, v_counts(frontier.size(), 0);
+    deque<SolverNode*> clustered;
+
+    for(size_t k = 0 ; k < frontier.size() ; k++)
+    {
+      // Previous clusters intersecting k in enough chunks
+      v_candidates.clear();
+      v_touched.clear();
+      for(int j = 0 ; j < nb_chunks ; j++)
+      {
+        v_indexes[j].intersecting(IntervalVector(1, v_signatures[k].chunk(j)[0]), v_ids);
+        for(size_t i = 0 ; i < v_ids.size() ; i++)
+        {
+          if(v_counts[v_ids[i]]++ == 0)
+            v_touched.push_back(v_ids[i]);
+          if(v_counts[v_ids[i]] == nb_required)
+            v_candidates.push_back(v_ids[i]);
+        }
+      }
+
+      for(size_t i = 0 ; i < v_touched.size() ; i++) // cleared for the next tube
+        v_counts[v_touched[i]] = 0;
+
+      sort(v_candidates.begin(), v_candidates.end()); // frontier order
+      bool merged = false;
+
+      for(size_t i = 0 ; i < v_candidates.size() && !merged ; i++)
+      {
+        int c = v_candidates[i]; // previous cluster
+
+        // Siblings are not merged: their union would be their parent
+        if(!SolverNode::siblings(frontier[c], frontier[k])
+          && v_signatures[k].may_overlap(v_signatures[c], m_clustering_ratio)
+          && v_x[k]->overlaps(*v_x[c], m_clustering_ratio))
+        {
+          *v_x[c] |= *v_x[k];
+          merged = true;
+          remove(c);
+          v_signatures[c] |= v_signatures[k];
+          insert(c);
+        }
+      }
+
+      if(merged)
+      {
+        m_pool.release(v_x[k]);
+        delete frontier[k];
+        stats.nb_clustered++;
+      }
+
+      else
+      {
+        insert(k);
+        frontier[k]->set_tube(v_x[k]); // possibly enlarged by next merges
+        clustered.push_back(frontier[k]);
+      }
+    }
+
+    frontier.swap(clustered);
+  }
+
+  const SolverStats& Solver::stats() const
+  {
+    return m_stats;
+  }
+
+  const list<TubeVector>& Solver::undecided() const
+  {
+    return m_undecided;
   }
 
   VIBesFigTubeVector* Solver::figure()
@@ -193,12 +1187,88 @@ namespace tubex
     return m_fig;
   }
 
+  void Solver::set_figure_refresh_period(double refresh_period)
+  {
+    assert(refresh_period >= 0.);
+    m_fig_refresh_period = refresh_period;
+  }
+
+  void Solver::start_figure_thread()
+  {
+    if(m_fig == NULL || m_fig_thread.joinable())
+      return;
+
+    m_fig_stop = false;
+    m_fig_thread = thread(&Solver::figure_loop, this);
+  }
+
+  void Solver::stop_figure_thread()
+  {
+    if(!m_fig_thread.joinable())
+      return;
+
+    {
+      lock_guard<mutex> lock(m_fig_mutex);
+      m_fig_stop = true;
+    }
+
+    m_fig_cv.notify_one();
+    m_fig_thread.join(); // pending solutions are drawn before the thread ends
+  }
+
+  void Solver::add_figure_solution(const TubeVector *x)
+  {
+    if(m_fig == NULL)
+      return;
+
+    ostringstream o; o << "solution_" << ++m_fig_nb_solutions;
+
+    {
+      lock_guard<mutex> lock(m_fig_mutex);
+      m_fig_pending.push_back(make_pair(x, o.str()));
+    }
+
+    m_fig_cv.notify_one();
+  }
+
+  void Solver::figure_loop()
+  {
+    m_fig->show(true);
+
+    unique_lock<mutex> lock(m_fig_mutex);
+    while(true)
+    {
+      m_fig_cv.wait(lock, [this] { return m_fig_stop || !m_fig_pending.empty(); });
+
+      bool stop = m_fig_stop;
+      vector<pair<const TubeVector*,string> > v_pending;
+      v_pending.swap(m_fig_pending);
+      lock.unlock();
+
+      // Drawing without the lock: the search can go on meanwhile
+      for(size_t k = 0 ; k < v_pending.size() ; k++)
+        m_fig->add_tubevector(v_pending[k].first, v_pending[k].second);
+      m_fig->show(true);
+
+      if(stop)
+        return;
+
+      // Rate limiting: solutions found during this period are drawn together
+      lock.lock();
+      m_fig_cv.wait_for(lock, chrono::duration<double>(m_fig_refresh_period), [this] { return m_fig_stop; });
+    }
+  }
+
   bool Solver::stopping_condition_met(const TubeVector& x)
   {
-    assert(x.size() == m_max_thickness.size());
+    return stopping_condition_met(x.max_diam());
+  }
+
+  bool Solver::stopping_condition_met(const Vector& x_max_thickness)
+  {
+    assert(x_max_thickness.size() == m_max_thickness.size());
 
-    Vector x_max_thickness = x.max_diam();
-    for(int i = 0 ; i < x.size() ; i++)
+    for(int i = 0 ; i < x_max_thickness.size() ; i++)
       if(x_max_thickness[i] > m_max_thickness[i])
         return false;
     return true;
@@ -214,55 +1284,188 @@ namespace tubex
     return (std::pow(volume_after, 1./n) / std::pow(volume_before, 1./n)) >= fxpt_ratio;
   }
 
-  void Solver::propagation(TubeVector &x, void (*ctc_func)(TubeVector&), float propa_fxpt_ratio)
+  int Solver::propagation(TubeVector &x, SolverContractor& ctc, float propa_fxpt_ratio, TubeSummary& summary)
   {
     assert(Interval(0.,1.).contains(propa_fxpt_ratio));
 
+    int nb_ctc_calls = 0;
     if(propa_fxpt_ratio == 0.)
-      return;
+      return nb_ctc_calls;
     
     bool emptiness;
     double volume_before_ctc;
 
+    // Only the time region modified by the previous pass is contracted
+    // again: the window grows as the contractions spread over the slices.
+    // The summary, describing x on entry, gives this window and the
+    // figures of the checks, scanning only the region of x that the
+    // contractor may have modified
+    Interval t_window = x.domain();
+
     do
     {
-      volume_before_ctc = x.volume();
-      ctc_func(x);
-      emptiness = x.is_empty();
+      volume_before_ctc = summary.volume();
+      Interval t_modified = ctc.contract_window(x, t_window);
+      nb_ctc_calls++;
+      t_window = summary.update(x, t_modified);
+      emptiness = summary.is_empty();
     } while(!emptiness
-         && !stopping_condition_met(x)
-         && !fixed_point_reached(volume_before_ctc, x.volume(), propa_fxpt_ratio));
+         && !t_window.is_empty() // nothing changed during the last pass
+         && !stopping_condition_met(summary.max_diam())
+         && !fixed_point_reached(volume_before_ctc, summary.volume(), propa_fxpt_ratio));
+
+    return nb_ctc_calls;
   }
 
-  void Solver::cid(TubeVector &x, void (*ctc_func)(TubeVector&))
+  void Solver::cid(TubeVector &x, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool)
   {
     if(m_cid_fxpt_ratio == 0.)
       return;
 
-    double t_bisection;
-    x[0].max_gate_diam(t_bisection);
-    pair<TubeVector,TubeVector> p_x = x.bisect(t_bisection);
-    pair<TubeVector,TubeVector> p_x_1 = p_x.first.bisect(t_bisection);
-    pair<TubeVector,TubeVector> p_x_2 = p_x.second.bisect(t_bisection);
-    x.set_empty();
-
-    stack<TubeVector> s;
-    //s.push(p_x.first);
-    //s.push(p_x.second);
-    s.push(p_x_1.first);
-    s.push(p_x_1.second);
-    s.push(p_x_2.first);
-    s.push(p_x_2.second);
-
-    while(!s.empty())
-    {
-      TubeVector branch_x = s.top();
-      s.pop();
-      propagation(branch_x, ctc_func, m_cid_fxpt_ratio);
-      x |= branch_x;
+    // A sweep handles the gates at several times,
+    // each one on the tube contracted by the previous ones
+    vector<double> v_t;
+    m_strategy->cid_times(x, m_max_thickness, m_cid_nb_times, v_t);
+
+    for(size_t j = 0 ; j < v_t.size() && !summary.is_empty() ; j++)
+    {
+      if(j > 0 && x(v_t[j]).max_diam() == 0.) // nothing to split
+        continue;
+
+      if(m_cid_shaving)
+        shaving(x, v_t[j], ctc, stats, summary, pool);
+
+      if(!summary.is_empty())
+        cid_split(x, v_t[j], ctc, stats, summary, pool);
+    }
+  }
+
+  void Solver::cid_split(TubeVector &x, double t, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool)
+  {
+    // The gate at t is split in nb_branches parts, by breadth-first
+    // bisections (four parts: as by two successive bisections of x).
+    // The first branch is x itself, contracted in place:
+    // the tube is copied nb_branches-1 times only.
+    deque<IntervalVector> d_gates(1, x(t));
+    while((int)d_gates.size() < m_cid_nb_splits)
+    {
+      int i = m_strategy->bisection_component(d_gates.front(), m_max_thickness);
+      pair<IntervalVector,IntervalVector> p_gate = SolverNode::bisect_gate(d_gates.front(), i);
+      d_gates.pop_front();
+      d_gates.push_back(p_gate.first);
+      d_gates.push_back(p_gate.second);
+    }
+
+    // The hull of the branches is computed in the same
+    // order whether they are processed concurrently or not
+    const int nb_branches = d_gates.size();
+    vector<TubeVector*> v_branches(nb_branches);
+    vector<TubeSummary*> v_summaries(nb_branches);
+    vector<int> v_nb_ctc_calls(nb_branches);
+
+    v_branches[0] = &x;
+    for(int k = 1 ; k < nb_branches ; k++)
+    {
+      v_branches[k] = pool.copy(x);
+      count_copy(x, stats);
+    }
+
+    v_summaries[0] = &summary;
+    for(int k = 1 ; k < nb_branches ; k++)
+      v_summaries[k] = new TubeSummary();
+
+    for(int k = 0 ; k < nb_branches ; k++)
+    {
+      v_branches[k]->set(d_gates[nb_branches - 1 - k], t);
+      v_summaries[k]->reset(*v_branches[k]);
+    }
+
+    if(m_cid_threads != NULL) // serial search: the threads are not busy
+    {
+      // Read only: the clones are prepared before the search
+      map<const SolverContractor*,vector<SolverContractor*> >::const_iterator it_clones = m_cid_clones.find(&ctc);
+      assert(it_clones != m_cid_clones.end() && (int)it_clones->second.size() >= nb_branches - 1 && "clones not prepared");
+      const vector<SolverContractor*>& v_clones = it_clones->second;
+
+      vector<function<void()> > v_tasks;
+      for(int k = 0 ; k < nb_branches ; k++)
+        v_tasks.push_back([&, k]
+          { v_nb_ctc_calls[k] = propagation(*v_branches[k], k == 0 ? ctc : *v_clones[k - 1], m_cid_fxpt_ratio, *v_summaries[k]); });
+      m_cid_threads->run(v_tasks);
+    }
+
+    else
+    {
+      for(int k = 0 ; k < nb_branches ; k++)
+        v_nb_ctc_calls[k] = propagation(*v_branches[k], ctc, m_cid_fxpt_ratio, *v_summaries[k]);
+    }
+
+    stats.nb_cid_ctc_calls += v_nb_ctc_calls[0];
+    for(int k = 1 ; k < nb_branches ; k++)
+    {
+      stats.nb_cid_ctc_calls += v_nb_ctc_calls[k];
+      if(!v_summaries[k]->is_empty()) // x remains empty if all branches are
+        x |= *v_branches[k];
+      pool.release(v_branches[k]);
+      delete v_summaries[k];
+    }
+
+    summary.update(x);
+  }
+
+  void Solver::shaving(TubeVector &x, double t, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool)
+  {
+    // 3B-like: for each component of the gate at t, the outer parts
+    // (of width diam/nb_splits) are removed from the gate as long as
+    // their propagation leads to an empty tube
+    IntervalVector gate = x(t);
+    bool shaved = false;
+    TubeSummary branch_summary;
+
+    for(int i = 0 ; i < gate.size() ; i++)
+    {
+      if(gate[i].is_unbounded())
+        continue;
+
+      double width = gate[i].diam() / m_cid_nb_splits;
+      for(int side = 0 ; side < 2 ; side++) // lower bound, then upper bound
+        while(width > 0. && gate[i].diam() > width) // one part is kept
+        {
+          IntervalVector branch_gate(gate);
+          branch_gate[i] = side == 0 ? Interval(gate[i].lb(), gate[i].lb() + width)
+                                     : Interval(gate[i].ub() - width, gate[i].ub());
+
+          TubeVector *branch = pool.copy(x);
+          count_copy(x, stats);
+          branch->set(branch_gate, t);
+          branch_summary.reset(*branch);
+          stats.nb_cid_ctc_calls += propagation(*branch, ctc, m_cid_fxpt_ratio, branch_summary);
+          pool.release(branch);
+
+          if(!branch_summary.is_empty())
+            break;
+
+          gate[i] = side == 0 ? Interval(branch_gate[i].ub(), gate[i].ub())
+                              : Interval(gate[i].lb(), branch_gate[i].lb());
+          shaved = true;
+        }
+    }
+
+    if(shaved)
+    {
+      x.set(gate, t);
+      summary.update(x, Interval(t));
+      stats.nb_cid_ctc_calls += propagation(x, ctc, m_cid_fxpt_ratio, summary);
     }
   }
   
+  void Solver::prepare_cid_clones(const SolverContractor& ctc)
+  {
+    vector<SolverContractor*>& v_clones = m_cid_clones[&ctc];
+    while((int)v_clones.size() < m_cid_nb_splits - 1) // one per concurrent CID branch
+      v_clones.push_back(ctc.clone());
+  }
+
   const BoolInterval Solver::solutions_contain(const list<TubeVector>& l_solutions, const TrajectoryVector& truth)
   {
     assert(!l_solutions.empty());
@@ -279,4 +1482,75 @@ namespace tubex
     
     return result;
   }
-}
\ No newline at end of file
+
+  const vector<BoolInterval> Solver::solutions_contain(const list<TubeVector>& l_solutions, const vector<const TrajectoryVector*>& v_truths, int nb_threads)
+  {
+    assert(!l_solutions.empty());
+    assert(nb_threads >= 0);
+
+    // Envelopes of the solutions, indexed, and their first and last gates
+
+    vector<const TubeVector*> v_solutions;
+    vector<IntervalVector> v_envelopes;
+    vector<pair<IntervalVector,IntervalVector> > v_bound_gates;
+    Interval range = Interval::EMPTY_SET;
+
+    for(list<TubeVector>::const_iterator it = l_solutions.begin() ; it != l_solutions.end() ; ++it)
+    {
+      v_solutions.push_back(&(*it));
+      v_envelopes.push_back(it->codomain());
+      v_bound_gates.push_back(make_pair((*it)(it->domain().lb()), (*it)(it->domain().ub())));
+      if(!v_envelopes.back()[0].is_unbounded())
+        range |= v_envelopes.back()[0];
+    }
+
+    EnvelopeIndex index(range, v_solutions.size());
+    for(size_t k = 0 ; k < v_envelopes.size() ; k++)
+      index.insert(k, v_envelopes[k]);
+
+    // Each truth is checked against the solutions whose envelope meets
+    // its range, and whose bound gates meet its bound values: a solution
+    // that does not may only return NO from the full test
+
+    vector<BoolInterval> v_results(v_truths.size(), NO);
+    atomic<size_t> next_truth(0);
+
+    auto check_truths = [&]()
+    {
+      vector<int> v_candidates;
+      for(size_t j = next_truth++ ; j < v_truths.size() ; j = next_truth++)
+      {
+        const TrajectoryVector& truth = *v_truths[j];
+        index.intersecting(truth.codomain(), v_candidates);
+
+        for(size_t i = 0 ; i < v_candidates.size() && v_results[j] != YES ; i++)
+        {
+          int k = v_candidates[i]; // in the order of the list
+          assert(truth.size() == v_solutions[k]->size());
+          const Interval& domain = v_solutions[k]->domain();
+
+          if(!truth(Interval(domain.lb())).intersects(v_bound_gates[k].first)
+            || !truth(Interval(domain.ub())).intersects(v_bound_gates[k].second))
+            continue;
+
+          BoolInterval b = v_solutions[k]->contains(truth);
+          if(b != NO)
+            v_results[j] = b; // YES, or MAYBE while no YES
+        }
+      }
+    };
+
+    if(nb_threads == 0)
+      nb_threads = std::max(1, (int)thread::hardware_concurrency());
+    nb_threads = std::min(nb_threads, (int)v_truths.size());
+
+    vector<thread> v_threads;
+    for(int i = 1 ; i < nb_threads ; i++)
+      v_threads.push_back(thread(check_truths));
+    check_truths();
+    for(size_t i = 0 ; i < v_threads.size() ; i++)
+      v_threads[i].join();
+
+    return v_results;
+  }
+}
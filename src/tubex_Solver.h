@@ -12,19 +12,42 @@
 #define __TUBEX_SOLVER_H__
 
 #include <list>
+#include <map>
+#include <vector>
+#include <functional>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 #include <ibex.h>
 #include "tubex_TubeVector.h"
 #include "tubex_TrajectoryVector.h"
 #include "tubex_VIBesFigTubeVector.h"
+#include "tubex_SolverContractor.h"
+#include "tubex_SolverStats.h"
+#include "tubex_SolverNode.h"
+#include "tubex_BisectionStrategy.h"
+#include "tubex_TubeSummary.h"
+#include "tubex_TubePool.h"
+#include "tubex_ThreadPool.h"
+#include "tubex_SolverLogger.h"
+#include "tubex_SolutionFile.h"
 #include "ibex_BoolInterval.h"
 
 namespace tubex
 {
+  // Called on each solution as soon as it is found;
+  // returning false stops the search
+  typedef std::function<bool(const TubeVector&)> SolutionCallback;
+
   class Solver
   {
     public:
 
-      Solver(const ibex::Vector& max_thickness);
+      // Without graphics, no VIBes figure is created (figure() returns NULL)
+      Solver(const ibex::Vector& max_thickness, bool graphics = true);
       ~Solver();
 
       // Ratio:
@@ -33,26 +56,178 @@ namespace tubex
       void set_refining_fxpt_ratio(float refining_fxpt_ratio);
       void set_propa_fxpt_ratio(float propa_fxpt_ratio);
       void set_cid_fxpt_ratio(float cid_fxpt_ratio);
+
+      // Number of slices sampled by each refining iteration, adapted up to
+      // max_batch: doubled while the contraction gained per sample holds,
+      // halved otherwise (1 = one sample per iteration, default)
+      void set_max_refining_batch(int max_batch);
+
+      // Number of threads exploring the bisection tree:
+      // 1 = serial search (default)
+      // 0 = as many threads as hardware cores
+      // Note: in a parallel search, each thread contracts with its own
+      // clone of the SolverContractor (a ctc_func is called concurrently)
+      void set_nb_threads(int nb_threads);
+
+      // Number of worker processes exploring the bisection tree (1 = none,
+      // default; 0 = as many as hardware cores). Workers are forked by
+      // solve(): each one contracts with its own copy of the contractor,
+      // in its own address space, and receives subtrees of the frontier
+      // through a local socket. Takes precedence over set_nb_threads
+      // Note: no clustering is applied, and the budgets are checked
+      // between two subtrees (of at most 64 nodes) explored by a worker
+      void set_nb_processes(int nb_processes);
+
+      // CID branches contracted concurrently (false by default)
+      // Note: branches are contracted by clones of the SolverContractor,
+      // on threads started once for the search. Only in a serial search:
+      // with several threads or processes, the cores are already busy
+      // and the branches of each worker are contracted one after the other
+      void set_parallel_cid(bool parallel_cid);
+
+      // CID sweep: the gates are split into nb_splits branches (4 by
+      // default), at up to nb_times times (1 by default): the time given
+      // by the bisection strategy, then the times of the widest gate of
+      // each component. With shaving (false by default), the outer parts
+      // of each component of these gates are first removed while their
+      // propagation proves them inconsistent
+      void set_cid_splits(int nb_splits);
+      void set_cid_nb_times(int nb_times);
+      void set_cid_shaving(bool shaving);
+
+      // Merging of the frontier tubes that overlap by more than the
+      // given ratio (0 = no clustering, default); serial search only
+      void set_clustering_ratio(float clustering_ratio);
+
+      // Times of bisection, refining and CID (FirstComponentBisection by
+      // default); the strategy is not copied and must outlive the solver
+      void set_bisection_strategy(const BisectionStrategy& strategy);
+
+      // Outputs of the search: on the standard output by default,
+      // with the level SOLUTIONS; the logger is not copied and must
+      // outlive the solver
+      void set_logger(SolverLogger& logger);
+      SolverLogger& logger();
+
+      // Early termination of the search:
+      // the search stops once max_solutions have been found (0 = no limit,
+      // default) or when the callback returns false
+      // Note: in a parallel search, solutions are delivered in the order
+      // they are found, and the callback is never called concurrently
+      void set_max_solutions(int max_solutions);
+      void set_solution_callback(const SolutionCallback& callback);
+
+      // Anytime resolution: the search stops when a budget is exhausted
+      // (0 = no limit, default), when cancel() is called from another
+      // thread, or on SIGINT if interruptible. Solutions found so far are
+      // returned; the frontier tubes, not explored, are available from
+      // undecided(): both sets enclose all the solutions of the problem
+      void set_time_limit(double time_limit);
+      void set_max_nodes(int max_nodes);
+      void set_interruptible(bool interruptible);
+      void cancel();
+
+      // Checkpoints: the state of the search (parameters, frontier and
+      // solutions) is saved in file_path every period seconds (serial
+      // search only) and when the search ends or is stopped
+      void set_checkpoint(const std::string& file_path, double period = 60.);
+
+      // Binary file of the solutions (see SolutionReader), created by each
+      // search: solutions are appended as they are delivered (order of
+      // discovery in a parallel search), after those of a resumed search
+      void set_solution_file(const std::string& file_path);
       
       const std::list<TubeVector> solve(const TubeVector& x0, void (*ctc_func)(TubeVector&));
+      const std::list<TubeVector> solve(const TubeVector& x0, SolverContractor& ctc);
+      // Continues the search saved in a checkpoint file
+      const std::list<TubeVector> resume(const std::string& file_path, SolverContractor& ctc);
+      // Figures of the last resolution
+      const SolverStats& stats() const;
+      const std::list<TubeVector>& undecided() const;
       VIBesFigTubeVector* figure();
+      // Minimal duration (in seconds) between two redraws of the figure
+      void set_figure_refresh_period(double refresh_period);
       static const ibex::BoolInterval solutions_contain(const std::list<TubeVector>& l_solutions, const TrajectoryVector& truth);
+      // Batch version: result of solutions_contain() for each truth.
+      // Solutions whose envelope or bound gates cannot enclose a truth are
+      // rejected through an index, before the full containment test. The
+      // truths are spread over nb_threads threads (0 = as many as hardware
+      // cores), each truth being evaluated by one thread only
+      static const std::vector<ibex::BoolInterval> solutions_contain(const std::list<TubeVector>& l_solutions,
+                                                                     const std::vector<const TrajectoryVector*>& v_truths,
+                                                                     int nb_threads = 0);
 
     protected:
       
-      void clustering(std::list<std::pair<int,TubeVector> >& l_tubes);
+      void clustering(std::deque<SolverNode*>& frontier, SolverStats& stats);
+      bool contract_node(TubeVector& x, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool);
+      void search(std::deque<SolverNode*>& frontier, std::list<TubeVector>& l_solutions, SolverContractor& ctc);
+      void solve_parallel(std::deque<SolverNode*>& frontier, SolverContractor& ctc, std::list<TubeVector>& l_solutions, int nb_threads);
+      void solve_processes(std::deque<SolverNode*>& frontier, SolverContractor& ctc, std::list<TubeVector>& l_solutions, int nb_processes);
+      void process_worker(int fd, SolverContractor& ctc);
+      void save_checkpoint(const std::deque<SolverNode*>& frontier, const std::list<TubeVector>& l_solutions);
+      void load_checkpoint(const std::string& file_path, std::deque<SolverNode*>& frontier, std::list<TubeVector>& l_solutions);
       bool stopping_condition_met(const TubeVector& x);
+      bool stopping_condition_met(const ibex::Vector& x_max_thickness);
+      bool deliver_solution(const TubeVector& x, int nb_solutions);
+      bool budget_exhausted(double elapsed_time, int nb_nodes) const;
+      void set_undecided(std::deque<SolverNode*>& frontier);
       bool fixed_point_reached(double volume_before, double volume_after, float fxpt_ratio);
-      void propagation(TubeVector &x, void (*ctc_func)(TubeVector&), float propa_fxpt_ratio);
-      void cid(TubeVector &x, void (*ctc_func)(TubeVector&));
+      int propagation(TubeVector &x, SolverContractor& ctc, float propa_fxpt_ratio, TubeSummary& summary);
+      void cid(TubeVector &x, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool);
+      void cid_split(TubeVector &x, double t, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool);
+      void shaving(TubeVector &x, double t, SolverContractor& ctc, SolverStats& stats, TubeSummary& summary, TubePool& pool);
+      void prepare_cid_clones(const SolverContractor& ctc);
+      void start_figure_thread();
+      void stop_figure_thread();
+      void add_figure_solution(const TubeVector *x);
+      void figure_loop();
+      TubeVector* node_tube(SolverNode& node, SolverStats& stats, TubePool& pool);
+      static void count_copy(const TubeVector& x, SolverStats& stats);
 
       ibex::Vector m_max_thickness = ibex::Vector(1);
       float m_refining_fxpt_ratio = 0.005;
       float m_propa_fxpt_ratio = 0.005;
       float m_cid_fxpt_ratio = 0.005;
+      int m_max_refining_batch = 1;
+      int m_nb_threads = 1;
+      int m_nb_processes = 1;
+      bool m_parallel_cid = false;
+      int m_cid_nb_splits = 4;
+      int m_cid_nb_times = 1;
+      bool m_cid_shaving = false;
+      float m_clustering_ratio = 0.;
+      int m_max_solutions = 0;
+      SolutionCallback m_solution_callback;
+      double m_time_limit = 0.;
+      int m_max_nodes = 0;
+      bool m_interruptible = false;
+      std::atomic<bool> m_cancel;
+      std::list<TubeVector> m_undecided;
+      std::string m_checkpoint_path;
+      double m_checkpoint_period = 60.;
+      std::string m_solution_file_path;
+      SolutionWriter *m_solution_writer = NULL; // during a search
+      const BisectionStrategy *m_strategy;
+      SolverStats m_stats;
+      TubePool m_pool; // tubes of the serial search, recycled
+      // Instances contracting the CID branches concurrently, built for
+      // each contractor of a search and released at its end
+      std::map<const SolverContractor*,std::vector<SolverContractor*> > m_cid_clones;
+      ThreadPool *m_cid_threads = NULL; // during a serial search with parallel CID
+      StreamLogger m_default_logger;
+      SolverLogger *m_logger = &m_default_logger;
 
-      // Embedded graphics
+      // Embedded graphics, drawn by a background thread so that
+      // redraws never block the search
       VIBesFigTubeVector *m_fig = NULL;
+      double m_fig_refresh_period = 0.5;
+      int m_fig_nb_solutions = 0;
+      std::thread m_fig_thread;
+      std::mutex m_fig_mutex;
+      std::condition_variable m_fig_cv;
+      bool m_fig_stop = false;
+      std::vector<std::pair<const TubeVector*,std::string> > m_fig_pending; // solutions to be added to the figure
   };
 }
 
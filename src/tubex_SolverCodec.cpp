@@ -0,0 +1,310 @@
+/** 
+ *  SolverCodec classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstdint>
+#include "tubex_SolverCodec.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // BinaryWriter
+
+  BinaryWriter::BinaryWriter(ostream& stream) : m_stream(stream)
+  {
+
+  }
+
+  void BinaryWriter::write_int(int i)
+  {
+    write_bytes(&i, sizeof(int));
+  }
+
+  void BinaryWriter::write_long(long i)
+  {
+    write_bytes(&i, sizeof(long));
+  }
+
+  void BinaryWriter::write_double(double d)
+  {
+    write_bytes(&d, sizeof(double));
+  }
+
+  void BinaryWriter::write_bytes(const void *data, size_t size)
+  {
+    m_stream.write(static_cast<const char*>(data), size);
+  }
+
+  void BinaryWriter::write_interval(const Interval& x)
+  {
+    // The empty set is encoded as [1,0] (bounds of an empty Interval
+    // are not specified)
+    write_double(x.is_empty() ? 1. : x.lb());
+    write_double(x.is_empty() ? 0. : x.ub());
+  }
+
+  void BinaryWriter::write_intervalvector(const IntervalVector& x)
+  {
+    write_int(x.size());
+    for(int i = 0 ; i < x.size() ; i++)
+      write_interval(x[i]);
+  }
+
+  void BinaryWriter::write_vector(const Vector& x)
+  {
+    write_int(x.size());
+    for(int i = 0 ; i < x.size() ; i++)
+      write_double(x[i]);
+  }
+
+  void BinaryWriter::write_tubevector(const TubeVector& x)
+  {
+    write_int(x.size());
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      write_int(x[i].nb_slices());
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        write_interval(s->domain());
+        write_interval(s->codomain());
+        write_interval(s->input_gate());
+      }
+      write_interval(x[i].last_slice()->output_gate());
+    }
+  }
+
+  // BinaryReader
+
+  BinaryReader::BinaryReader(const char *data, size_t size) : m_data(data), m_size(size)
+  {
+
+  }
+
+  int BinaryReader::read_int()
+  {
+    int i;
+    read_bytes(&i, sizeof(int));
+    return i;
+  }
+
+  long BinaryReader::read_long()
+  {
+    long i;
+    read_bytes(&i, sizeof(long));
+    return i;
+  }
+
+  double BinaryReader::read_double()
+  {
+    double d;
+    read_bytes(&d, sizeof(double));
+    return d;
+  }
+
+  void BinaryReader::read_bytes(void *data, size_t size)
+  {
+    if(size > m_size - m_offset)
+      throw Exception(__func__, "unexpected end of binary data");
+    memcpy(data, m_data + m_offset, size);
+    m_offset += size;
+  }
+
+  const Interval BinaryReader::read_interval()
+  {
+    double lb = read_double();
+    double ub = read_double();
+    return lb > ub ? Interval::EMPTY_SET : Interval(lb, ub);
+  }
+
+  const IntervalVector BinaryReader::read_intervalvector()
+  {
+    int n = read_int();
+    if(n <= 0)
+      throw Exception(__func__, "invalid vector size in binary data");
+    IntervalVector x(n);
+    for(int i = 0 ; i < n ; i++)
+      x[i] = read_interval();
+    return x;
+  }
+
+  const Vector BinaryReader::read_vector()
+  {
+    int n = read_int();
+    if(n <= 0)
+      throw Exception(__func__, "invalid vector size in binary data");
+    Vector x(n);
+    for(int i = 0 ; i < n ; i++)
+      x[i] = read_double();
+    return x;
+  }
+
+  TubeVector* BinaryReader::read_tubevector()
+  {
+    int n = read_int();
+    if(n <= 0)
+      throw Exception(__func__, "invalid tube size in binary data");
+
+    unique_ptr<TubeVector> x; // deleted if the data is truncated or invalid
+    vector<Interval> v_domains, v_codomains, v_gates;
+
+    for(int i = 0 ; i < n ; i++)
+    {
+      int nb_slices = read_int();
+      if(nb_slices <= 0)
+        throw Exception(__func__, "invalid number of slices in binary data");
+
+      v_domains.resize(nb_slices);
+      v_codomains.resize(nb_slices);
+      v_gates.resize(nb_slices + 1);
+      for(int k = 0 ; k < nb_slices ; k++)
+      {
+        v_domains[k] = read_interval();
+        v_codomains[k] = read_interval();
+        v_gates[k] = read_interval();
+      }
+      v_gates[nb_slices] = read_interval();
+
+      Tube tube(v_domains, v_codomains);
+      int k = 0;
+      for(Slice *s = tube.first_slice() ; s != NULL ; s = s->next_slice())
+        s->set_input_gate(v_gates[k++], false);
+      tube.last_slice()->set_output_gate(v_gates[nb_slices], false);
+
+      if(!x)
+        x.reset(new TubeVector(n, tube));
+      else
+        (*x)[i] = tube;
+    }
+
+    return x.release();
+  }
+
+  bool BinaryReader::at_end() const
+  {
+    return m_offset == m_size;
+  }
+
+  size_t BinaryReader::offset() const
+  {
+    return m_offset;
+  }
+
+  void BinaryReader::skip_to(size_t offset)
+  {
+    if(offset > m_size)
+      throw Exception(__func__, "unexpected end of binary data");
+    m_offset = offset;
+  }
+
+  // Messages
+
+  bool write_message(int fd, const string& message)
+  {
+    uint64_t size = message.size();
+    string frame(reinterpret_cast<const char*>(&size), sizeof(size));
+    frame += message;
+
+    for(size_t offset = 0 ; offset < frame.size() ; )
+    {
+      // No SIGPIPE if the peer has terminated: the error is returned
+      ssize_t n = send(fd, frame.data() + offset, frame.size() - offset, MSG_NOSIGNAL);
+      if(n == -1 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        return false;
+      offset += n;
+    }
+
+    return true;
+  }
+
+  static bool read_bytes(int fd, char *data, size_t size)
+  {
+    for(size_t offset = 0 ; offset < size ; )
+    {
+      ssize_t n = recv(fd, data + offset, size - offset, 0);
+      if(n == -1 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        return false;
+      offset += n;
+    }
+
+    return true;
+  }
+
+  bool read_message(int fd, string& message)
+  {
+    uint64_t size;
+    if(!read_bytes(fd, reinterpret_cast<char*>(&size), sizeof(size)))
+      return false;
+    message.resize(size);
+    return size == 0 || read_bytes(fd, &message[0], size);
+  }
+
+  // MappedFile
+
+  MappedFile::MappedFile(const string& file_path)
+  {
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if(fd == -1)
+      throw Exception(__func__, "unable to open " + file_path);
+
+    struct stat st;
+    if(fstat(fd, &st) == -1)
+    {
+      close(fd);
+      throw Exception(__func__, "unable to read " + file_path);
+    }
+
+    m_size = st.st_size;
+    if(m_size > 0)
+    {
+      void *data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(data == MAP_FAILED)
+      {
+        close(fd);
+        throw Exception(__func__, "unable to map " + file_path);
+      }
+
+      madvise(data, m_size, MADV_SEQUENTIAL);
+      m_data = static_cast<const char*>(data);
+    }
+
+    close(fd); // the mapping remains valid
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if(m_data != NULL)
+      munmap(const_cast<char*>(m_data), m_size);
+  }
+
+  const char* MappedFile::data() const
+  {
+    return m_data;
+  }
+
+  size_t MappedFile::size() const
+  {
+    return m_size;
+  }
+}
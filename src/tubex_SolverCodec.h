@@ -0,0 +1,102 @@
+/** 
+ *  SolverCodec classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_SOLVERCODEC_H__
+#define __TUBEX_SOLVERCODEC_H__
+
+#include <string>
+#include <ostream>
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * Compact binary encoding of the solver data (checkpoints, solutions).
+   *
+   * Values are written in the native byte order: files are meant to be
+   * read back on the machine that wrote them. A tube is encoded slice by
+   * slice (domain, envelope, input gate) so that its exact slicing and
+   * gates are restored.
+   */
+  class BinaryWriter
+  {
+    public:
+
+      BinaryWriter(std::ostream& stream);
+
+      void write_int(int i);
+      void write_long(long i);
+      void write_double(double d);
+      void write_bytes(const void *data, size_t size);
+      void write_interval(const ibex::Interval& x);
+      void write_intervalvector(const ibex::IntervalVector& x);
+      void write_vector(const ibex::Vector& x);
+      void write_tubevector(const TubeVector& x);
+
+    protected:
+
+      std::ostream& m_stream;
+  };
+
+  class BinaryReader
+  {
+    public:
+
+      // Reads the bytes in [data,data+size[ (not copied)
+      BinaryReader(const char *data, size_t size);
+
+      int read_int();
+      long read_long();
+      double read_double();
+      void read_bytes(void *data, size_t size);
+      const ibex::Interval read_interval();
+      const ibex::IntervalVector read_intervalvector();
+      const ibex::Vector read_vector();
+      TubeVector* read_tubevector(); // to be deleted by the caller
+
+      bool at_end() const;
+      size_t offset() const;
+      void skip_to(size_t offset);
+
+    protected:
+
+      const char *m_data;
+      size_t m_size;
+      size_t m_offset = 0;
+  };
+
+  // Framed messages (size, then bytes) over a stream socket:
+  // false if the peer closed the socket or on a write/read error
+  bool write_message(int fd, const std::string& message);
+  bool read_message(int fd, std::string& message);
+
+  /**
+   * Read-only memory mapping of a whole file, released on destruction.
+   */
+  class MappedFile
+  {
+    public:
+
+      MappedFile(const std::string& file_path);
+      ~MappedFile();
+      MappedFile(const MappedFile&) = delete;
+      MappedFile& operator=(const MappedFile&) = delete;
+
+      const char* data() const;
+      size_t size() const;
+
+    protected:
+
+      const char *m_data = NULL;
+      size_t m_size = 0;
+  };
+}
+
+#endif
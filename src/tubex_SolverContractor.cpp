@@ -0,0 +1,49 @@
+/** 
+ *  SolverContractor class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex_SolverContractor.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  SolverContractor::SolverContractor()
+  {
+
+  }
+
+  SolverContractor::~SolverContractor()
+  {
+
+  }
+
+  const Interval SolverContractor::contract_window(TubeVector& x, const Interval&)
+  {
+    contract(x);
+    return x.domain();
+  }
+
+  SolverCtcFunc::SolverCtcFunc(void (*ctc_func)(TubeVector&))
+    : m_ctc_func(ctc_func)
+  {
+    assert(ctc_func != NULL);
+  }
+
+  void SolverCtcFunc::contract(TubeVector& x)
+  {
+    m_ctc_func(x);
+  }
+
+  SolverContractor* SolverCtcFunc::clone() const
+  {
+    return new SolverCtcFunc(m_ctc_func);
+  }
+}
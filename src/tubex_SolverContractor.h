@@ -0,0 +1,62 @@
+/** 
+ *  SolverContractor class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_SOLVERCONTRACTOR_H__
+#define __TUBEX_SOLVERCONTRACTOR_H__
+
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * Contractor applied by the Solver on the tubes of the search.
+   * Unlike a contraction function, its setup (functions, systems,
+   * sub-contractors) is built once and reused for all the calls.
+   */
+  class SolverContractor
+  {
+    public:
+
+      SolverContractor();
+      virtual ~SolverContractor();
+
+      virtual void contract(TubeVector& x) = 0;
+
+      // Contraction restricted to the slices of t_window, the time region
+      // that changed during the previous pass of the propagation (the
+      // whole domain of x on a first pass). Returns the time region where
+      // x may have been contracted (slices and gates at its bounds), the
+      // only one scanned by the Solver afterwards; by default, the whole
+      // tube is contracted and x.domain() is returned
+      virtual const ibex::Interval contract_window(TubeVector& x, const ibex::Interval& t_window);
+
+      // Independent instance: in parallel modes, each thread
+      // contracts with its own clone
+      virtual SolverContractor* clone() const = 0;
+  };
+
+  /**
+   * SolverContractor calling a contraction function
+   */
+  class SolverCtcFunc : public SolverContractor
+  {
+    public:
+
+      SolverCtcFunc(void (*ctc_func)(TubeVector&));
+      void contract(TubeVector& x);
+      SolverContractor* clone() const;
+
+    protected:
+
+      void (*m_ctc_func)(TubeVector&);
+  };
+}
+
+#endif
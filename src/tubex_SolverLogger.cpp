@@ -0,0 +1,111 @@
+/** 
+ *  SolverLogger classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <sstream>
+#include <cassert>
+#include "tubex_SolverLogger.h"
+
+using namespace std;
+
+namespace tubex
+{
+  // SolverLogger
+
+  SolverLogger::SolverLogger(Level level) : m_level(level), m_last_progress(-1.)
+  {
+
+  }
+
+  SolverLogger::~SolverLogger()
+  {
+
+  }
+
+  void SolverLogger::set_level(Level level)
+  {
+    m_level = level;
+  }
+
+  bool SolverLogger::enabled(Level level) const
+  {
+    return level != QUIET && level <= m_level;
+  }
+
+  void SolverLogger::set_progress_period(double progress_period)
+  {
+    assert(progress_period >= 0.);
+    m_progress_period = progress_period;
+  }
+
+  void SolverLogger::message(Level level, const string& message)
+  {
+    if(!enabled(level))
+      return;
+
+    lock_guard<mutex> lock(m_mutex);
+    write(level, message, false);
+  }
+
+  void SolverLogger::progress(int nb_solutions, double elapsed_time, bool last)
+  {
+    if(!enabled(PROGRESS))
+      return;
+
+    // Most of the calls return here, without locking
+    double last_progress = m_last_progress;
+    if(!last && last_progress >= 0. && elapsed_time - last_progress < m_progress_period)
+      return;
+
+    lock_guard<mutex> lock(m_mutex);
+    last_progress = m_last_progress;
+    if(!last && last_progress >= 0. && elapsed_time - last_progress < m_progress_period)
+      return; // updated meanwhile by another thread
+    m_last_progress = last ? -1. : elapsed_time; // next search starts a new line
+
+    ostringstream o;
+    o << "Solutions: " << nb_solutions << "  (" << (int)elapsed_time << "s)   ";
+    write(PROGRESS, o.str(), !last);
+  }
+
+  void SolverLogger::flush()
+  {
+
+  }
+
+  // StreamLogger
+
+  StreamLogger::StreamLogger(ostream& os, Level level) : SolverLogger(level), m_os(os)
+  {
+
+  }
+
+  void StreamLogger::flush()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_os << std::flush;
+  }
+
+  void StreamLogger::write(Level level, const string& message, bool transient)
+  {
+    if(transient)
+    {
+      m_os << "\r" << message << std::flush;
+      m_transient = true;
+      return;
+    }
+
+    if(m_transient && level == PROGRESS) // final state of the progress line
+      m_os << "\r";
+    else if(m_transient)
+      m_os << "\n";
+    m_os << message << "\n";
+    m_transient = false;
+  }
+}
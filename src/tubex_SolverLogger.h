@@ -0,0 +1,85 @@
+/** 
+ *  SolverLogger classes
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_SOLVERLOGGER_H__
+#define __TUBEX_SOLVERLOGGER_H__
+
+#include <string>
+#include <iostream>
+#include <mutex>
+#include <atomic>
+
+namespace tubex
+{
+  /**
+   * Outputs of the Solver, filtered by a verbosity level.
+   *
+   * Each level includes the previous ones. Progress updates are
+   * throttled: at most one per progress period, plus the final one.
+   * The methods may be called concurrently by the solver threads.
+   * Derived classes define the sink (see write()).
+   */
+  class SolverLogger
+  {
+    public:
+
+      enum Level
+      {
+        QUIET = 0,     // no output
+        SUMMARY = 1,   // final time and stats
+        PROGRESS = 2,  // number of solutions during the search
+        SOLUTIONS = 3, // final report of the solutions (default)
+        NODES = 4      // one line per bisection
+      };
+
+      SolverLogger(Level level = SOLUTIONS);
+      virtual ~SolverLogger();
+
+      void set_level(Level level);
+      bool enabled(Level level) const;
+      // Minimal duration (in seconds) between two progress updates
+      void set_progress_period(double progress_period);
+
+      void message(Level level, const std::string& message);
+      // Last update forced (end of search), terminating the progress line
+      void progress(int nb_solutions, double elapsed_time, bool last = false);
+      virtual void flush();
+
+    protected:
+
+      // Writes a message; a transient one (progress)
+      // is replaced by the next message
+      virtual void write(Level level, const std::string& message, bool transient) = 0;
+
+      std::atomic<int> m_level;
+      double m_progress_period = 0.5;
+      std::atomic<double> m_last_progress; // elapsed time of the last update
+      std::mutex m_mutex;
+  };
+
+  // Messages written on a stream (standard output by default),
+  // flushed for progress updates only
+  class StreamLogger : public SolverLogger
+  {
+    public:
+
+      StreamLogger(std::ostream& os = std::cout, Level level = SOLUTIONS);
+      void flush();
+
+    protected:
+
+      void write(Level level, const std::string& message, bool transient);
+
+      std::ostream& m_os;
+      bool m_transient = false; // progress line being displayed
+  };
+}
+
+#endif
@@ -0,0 +1,186 @@
+/** 
+ *  SolverNode class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include "tubex_SolverNode.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  SolverNode::SolverNode(const TubeVector& x0)
+    : m_level(0), m_x(new SharedTube(new TubeVector(x0))), m_t(NAN), m_gate(x0.size())
+  {
+
+  }
+
+  SolverNode::SolverNode(const SolverNode& parent, const shared_ptr<SharedTube>& x,
+                         double t, const IntervalVector& gate, bool upper)
+    : m_level(parent.m_level + 1), m_path(parent.m_path), m_x(x), m_t(t), m_gate(gate)
+  {
+    m_path.push_back(upper);
+  }
+
+  SolverNode::SolverNode(int level, const vector<bool>& path, const shared_ptr<SharedTube>& x,
+                         double t, const IntervalVector& gate)
+    : m_level(level), m_path(path), m_x(x), m_t(t), m_gate(gate)
+  {
+
+  }
+
+  int SolverNode::level() const
+  {
+    return m_level;
+  }
+
+  const vector<bool>& SolverNode::path() const
+  {
+    return m_path;
+  }
+
+  TubeVector* SolverNode::tube(TubePool& pool, bool& copied)
+  {
+    assert(m_x && "tube already built");
+
+    TubeVector *x;
+    copied = m_x.use_count() > 1;
+
+    if(copied) // the sibling still needs the parent tube
+      x = pool.copy(*m_x->x);
+
+    else // last owner: the parent tube is taken
+    {
+      // The sibling may have copied the tube from another thread
+      // before releasing it: its reads must not race with our writes
+      atomic_thread_fence(memory_order_acquire);
+      x = m_x->x;
+      m_x->x = NULL;
+    }
+
+    m_x.reset();
+    if(!std::isnan(m_t))
+      x->set(m_gate, m_t);
+    return x;
+  }
+
+  void SolverNode::set_tube(TubeVector *x)
+  {
+    assert(!m_x && "tube not built");
+    assert(x != NULL);
+    m_x = shared_ptr<SharedTube>(new SharedTube(x));
+    m_t = NAN; // no more gate restriction
+  }
+
+  bool SolverNode::siblings(const SolverNode *n1, const SolverNode *n2)
+  {
+    return n1->m_level == n2->m_level && n1->m_level > 0
+        && equal(n1->m_path.begin(), n1->m_path.end() - 1, n2->m_path.begin());
+  }
+
+  pair<SolverNode*,SolverNode*> SolverNode::bisect(const SolverNode& node, TubeVector *x, double t, int i, float ratio)
+  {
+    assert(x != NULL && x->domain().contains(t));
+
+    pair<IntervalVector,IntervalVector> p_gate = bisect_gate((*x)(t), i, ratio);
+
+    shared_ptr<SharedTube> shared_x(new SharedTube(x));
+    return make_pair(new SolverNode(node, shared_x, t, p_gate.first, false),
+                     new SolverNode(node, shared_x, t, p_gate.second, true));
+  }
+
+  pair<IntervalVector,IntervalVector> SolverNode::bisect_gate(const IntervalVector& gate, int i, float ratio)
+  {
+    assert(i >= 0 && i < gate.size());
+    return gate.bisect(i, ratio);
+  }
+
+  bool SolverNode::bfs_order(const SolverNode *n1, const SolverNode *n2)
+  {
+    if(n1->m_level != n2->m_level)
+      return n1->m_level < n2->m_level;
+    return n1->m_path < n2->m_path;
+  }
+
+  void SolverNode::write_nodes(BinaryWriter& w, const deque<SolverNode*>& nodes)
+  {
+    map<const SharedTube*,int> m_ids;
+    vector<const SharedTube*> v_tubes;
+    for(size_t k = 0 ; k < nodes.size() ; k++)
+    {
+      assert(nodes[k]->m_x && "tube already built");
+      if(m_ids.insert(make_pair(nodes[k]->m_x.get(), (int)v_tubes.size())).second)
+        v_tubes.push_back(nodes[k]->m_x.get());
+    }
+
+    w.write_int(v_tubes.size());
+    for(size_t i = 0 ; i < v_tubes.size() ; i++)
+      w.write_tubevector(*v_tubes[i]->x);
+
+    w.write_int(nodes.size());
+    for(size_t k = 0 ; k < nodes.size() ; k++)
+    {
+      const SolverNode *node = nodes[k];
+      w.write_int(node->m_level);
+      w.write_int(node->m_path.size());
+      vector<char> v_bits((node->m_path.size() + 7) / 8, 0);
+      for(size_t i = 0 ; i < node->m_path.size() ; i++)
+        if(node->m_path[i])
+          v_bits[i / 8] |= 1 << (i % 8);
+      w.write_bytes(v_bits.data(), v_bits.size());
+      w.write_int(m_ids[node->m_x.get()]);
+      w.write_double(node->m_t);
+      w.write_intervalvector(node->m_gate);
+    }
+  }
+
+  void SolverNode::read_nodes(BinaryReader& r, deque<SolverNode*>& nodes)
+  {
+    // Nothing is added to nodes, and all is deleted,
+    // if the data is truncated or invalid
+    int nb_tubes = r.read_int();
+    vector<shared_ptr<SharedTube> > v_tubes;
+    for(int i = 0 ; i < nb_tubes ; i++)
+    {
+      unique_ptr<TubeVector> x(r.read_tubevector());
+      v_tubes.push_back(make_shared<SharedTube>(x.get()));
+      x.release(); // now owned by the shared tube
+    }
+
+    int nb_nodes = r.read_int();
+    vector<unique_ptr<SolverNode> > v_nodes;
+    for(int k = 0 ; k < nb_nodes ; k++)
+    {
+      int level = r.read_int();
+      int path_size = r.read_int();
+      if(path_size < 0)
+        throw Exception(__func__, "invalid node path in binary data");
+      vector<char> v_bits((path_size + 7) / 8);
+      r.read_bytes(v_bits.data(), v_bits.size());
+      vector<bool> path(path_size);
+      for(int i = 0 ; i < path_size ; i++)
+        path[i] = (v_bits[i / 8] >> (i % 8)) & 1;
+
+      int id = r.read_int();
+      if(id < 0 || id >= nb_tubes)
+        throw Exception(__func__, "invalid node tube in binary data");
+      double t = r.read_double();
+      IntervalVector gate = r.read_intervalvector();
+      v_nodes.push_back(unique_ptr<SolverNode>(new SolverNode(level, path, v_tubes[id], t, gate)));
+    }
+
+    for(size_t k = 0 ; k < v_nodes.size() ; k++)
+      nodes.push_back(v_nodes[k].release());
+  }
+}
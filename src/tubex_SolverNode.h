@@ -0,0 +1,98 @@
+/** 
+ *  SolverNode class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_SOLVERNODE_H__
+#define __TUBEX_SOLVERNODE_H__
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include "tubex_TubeVector.h"
+#include "tubex_SolverCodec.h"
+#include "tubex_TubePool.h"
+
+namespace tubex
+{
+  /**
+   * Node of the bisection tree explored by the Solver.
+   *
+   * The two children of a bisection differ from their parent only by
+   * the gate at the bisection time: they share the tube of the parent
+   * and only store their own half of this gate. The tube of a node is
+   * built when the node is popped from the frontier: the first child
+   * copies the parent tube, the last one takes it without copy.
+   *
+   * A node is identified by its depth and by the path (sequence of
+   * lower/upper halves) followed from the root.
+   */
+  class SolverNode
+  {
+    public:
+
+      // Root of the search tree
+      SolverNode(const TubeVector& x0);
+
+      int level() const;
+      const std::vector<bool>& path() const;
+
+      // Tube of the node (to be deleted by the caller): parent tube,
+      // restricted to the gate of this node. The parent tube is copied
+      // only if it is still shared with the sibling (copied is then true),
+      // in a tube of the pool. Note: to be called once
+      TubeVector* tube(TubePool& pool, bool& copied);
+
+      // Replaces the tube of the node by x (ownership is transferred),
+      // once the node has been built (see tube())
+      void set_tube(TubeVector *x);
+
+      // True if n1 and n2 are the two children of a same bisection
+      static bool siblings(const SolverNode *n1, const SolverNode *n2);
+
+      // Children of a node whose contracted tube x is bisected at t
+      // along the component i of the gate (see BisectionStrategy):
+      // the ownership of x is transferred to the children
+      static std::pair<SolverNode*,SolverNode*> bisect(const SolverNode& node, TubeVector *x, double t, int i, float ratio = 0.49);
+
+      // Bisection of a gate along its component i
+      static std::pair<ibex::IntervalVector,ibex::IntervalVector> bisect_gate(const ibex::IntervalVector& gate, int i, float ratio = 0.49);
+
+      // Order in which the serial breadth-first search meets the nodes
+      static bool bfs_order(const SolverNode *n1, const SolverNode *n2);
+
+      // Serialization of nodes whose tube is not built yet:
+      // a tube shared by two siblings is written once
+      static void write_nodes(BinaryWriter& w, const std::deque<SolverNode*>& nodes);
+      static void read_nodes(BinaryReader& r, std::deque<SolverNode*>& nodes);
+
+    protected:
+
+      // Tube owned by the two children of a bisection,
+      // until one of them takes it
+      struct SharedTube
+      {
+        SharedTube(TubeVector *x_) : x(x_) { }
+        ~SharedTube() { delete x; }
+        TubeVector *x;
+      };
+
+      SolverNode(const SolverNode& parent, const std::shared_ptr<SharedTube>& x,
+                 double t, const ibex::IntervalVector& gate, bool upper);
+      SolverNode(int level, const std::vector<bool>& path, const std::shared_ptr<SharedTube>& x,
+                 double t, const ibex::IntervalVector& gate);
+
+      int m_level;
+      std::vector<bool> m_path;
+      std::shared_ptr<SharedTube> m_x; // tube shared with the sibling node
+      double m_t; // bisection time (NaN for the root)
+      ibex::IntervalVector m_gate; // gate of this node at m_t
+  };
+}
+
+#endif
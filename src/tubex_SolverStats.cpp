@@ -0,0 +1,220 @@
+/** 
+ *  SolverStats class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "tubex_SolverStats.h"
+#include "tubex_Exception.h"
+#include "tubex_SolverCodec.h"
+
+using namespace std;
+
+namespace tubex
+{
+  // JSON has no representation of oo or NaN
+  static const string json_number(double x)
+  {
+    if(!std::isfinite(x))
+      return "null";
+    ostringstream o;
+    o.precision(17);
+    o << x;
+    return o.str();
+  }
+
+  SolverStats::SolverStats()
+  {
+    reset();
+  }
+
+  void SolverStats::reset()
+  {
+    strategy = "";
+    nb_nodes = 0;
+    nb_bisections = 0;
+    nb_empty_prunes = 0;
+    max_frontier_size = 0;
+    nb_clustered = 0;
+    nb_solutions = 0;
+    nb_undecided = 0;
+    nb_tube_copies = 0;
+    nb_slice_copies = 0;
+    nb_recycled_tubes = 0;
+    nb_refining_iterations = 0;
+    nb_refining_samples = 0;
+    nb_propa_ctc_calls = 0;
+    nb_cid_ctc_calls = 0;
+    t_refining = 0.;
+    t_propagation = 0.;
+    t_cid = 0.;
+    t_bisection = 0.;
+    t_total = 0.;
+    propa_volume_reduction = 0.;
+    cid_volume_reduction = 0.;
+  }
+
+  SolverStats& SolverStats::operator+=(const SolverStats& s)
+  {
+    nb_nodes += s.nb_nodes;
+    nb_bisections += s.nb_bisections;
+    nb_empty_prunes += s.nb_empty_prunes;
+    max_frontier_size = std::max(max_frontier_size, s.max_frontier_size);
+    nb_clustered += s.nb_clustered;
+    nb_solutions += s.nb_solutions;
+    nb_undecided += s.nb_undecided;
+    nb_tube_copies += s.nb_tube_copies;
+    nb_slice_copies += s.nb_slice_copies;
+    nb_recycled_tubes += s.nb_recycled_tubes;
+    nb_refining_iterations += s.nb_refining_iterations;
+    nb_refining_samples += s.nb_refining_samples;
+    nb_propa_ctc_calls += s.nb_propa_ctc_calls;
+    nb_cid_ctc_calls += s.nb_cid_ctc_calls;
+    t_refining += s.t_refining;
+    t_propagation += s.t_propagation;
+    t_cid += s.t_cid;
+    t_bisection += s.t_bisection;
+    t_total = std::max(t_total, s.t_total);
+    propa_volume_reduction += s.propa_volume_reduction;
+    cid_volume_reduction += s.cid_volume_reduction;
+    return *this;
+  }
+
+  void SolverStats::write(BinaryWriter& w) const
+  {
+    // The strategy name is not written: it is the same for all workers
+    w.write_int(nb_nodes);
+    w.write_int(nb_bisections);
+    w.write_int(nb_empty_prunes);
+    w.write_int(max_frontier_size);
+    w.write_int(nb_clustered);
+    w.write_int(nb_solutions);
+    w.write_int(nb_undecided);
+    w.write_int(nb_tube_copies);
+    w.write_long(nb_slice_copies);
+    w.write_int(nb_recycled_tubes);
+    w.write_int(nb_refining_iterations);
+    w.write_int(nb_refining_samples);
+    w.write_int(nb_propa_ctc_calls);
+    w.write_int(nb_cid_ctc_calls);
+    w.write_double(t_refining);
+    w.write_double(t_propagation);
+    w.write_double(t_cid);
+    w.write_double(t_bisection);
+    w.write_double(t_total);
+    w.write_double(propa_volume_reduction);
+    w.write_double(cid_volume_reduction);
+  }
+
+  void SolverStats::read(BinaryReader& r)
+  {
+    nb_nodes = r.read_int();
+    nb_bisections = r.read_int();
+    nb_empty_prunes = r.read_int();
+    max_frontier_size = r.read_int();
+    nb_clustered = r.read_int();
+    nb_solutions = r.read_int();
+    nb_undecided = r.read_int();
+    nb_tube_copies = r.read_int();
+    nb_slice_copies = r.read_long();
+    nb_recycled_tubes = r.read_int();
+    nb_refining_iterations = r.read_int();
+    nb_refining_samples = r.read_int();
+    nb_propa_ctc_calls = r.read_int();
+    nb_cid_ctc_calls = r.read_int();
+    t_refining = r.read_double();
+    t_propagation = r.read_double();
+    t_cid = r.read_double();
+    t_bisection = r.read_double();
+    t_total = r.read_double();
+    propa_volume_reduction = r.read_double();
+    cid_volume_reduction = r.read_double();
+  }
+
+  const string SolverStats::to_json() const
+  {
+    ostringstream o;
+    o.precision(17);
+    o << "{"
+      << "\"strategy\": \"" << strategy << "\", "
+      << "\"nb_nodes\": " << nb_nodes << ", "
+      << "\"nb_bisections\": " << nb_bisections << ", "
+      << "\"nb_empty_prunes\": " << nb_empty_prunes << ", "
+      << "\"max_frontier_size\": " << max_frontier_size << ", "
+      << "\"nb_clustered\": " << nb_clustered << ", "
+      << "\"nb_solutions\": " << nb_solutions << ", "
+      << "\"nb_undecided\": " << nb_undecided << ", "
+      << "\"nb_tube_copies\": " << nb_tube_copies << ", "
+      << "\"nb_slice_copies\": " << nb_slice_copies << ", "
+      << "\"nb_recycled_tubes\": " << nb_recycled_tubes << ", "
+      << "\"nb_refining_iterations\": " << nb_refining_iterations << ", "
+      << "\"nb_refining_samples\": " << nb_refining_samples << ", "
+      << "\"nb_propa_ctc_calls\": " << nb_propa_ctc_calls << ", "
+      << "\"nb_cid_ctc_calls\": " << nb_cid_ctc_calls << ", "
+      << "\"t_refining\": " << json_number(t_refining) << ", "
+      << "\"t_propagation\": " << json_number(t_propagation) << ", "
+      << "\"t_cid\": " << json_number(t_cid) << ", "
+      << "\"t_bisection\": " << json_number(t_bisection) << ", "
+      << "\"t_total\": " << json_number(t_total) << ", "
+      << "\"propa_volume_reduction\": " << json_number(propa_volume_reduction) << ", "
+      << "\"cid_volume_reduction\": " << json_number(cid_volume_reduction)
+      << "}";
+    return o.str();
+  }
+
+  void SolverStats::save_json(const string& file_path) const
+  {
+    ofstream f(file_path.c_str());
+    if(!f.is_open())
+      throw Exception(__func__, "unable to write solver stats in " + file_path);
+    f << to_json() << endl;
+  }
+
+  ostream& operator<<(ostream& str, const SolverStats& s)
+  {
+    str << "Bisection strategy: " << s.strategy << endl
+        << "Nodes: " << s.nb_nodes
+        << " (bisections: " << s.nb_bisections
+        << ", empty: " << s.nb_empty_prunes
+        << ", max frontier: " << s.max_frontier_size
+        << ", clustered: " << s.nb_clustered
+        << ", solutions: " << s.nb_solutions
+        << ", undecided: " << s.nb_undecided << ")" << endl
+        << "Tube copies: " << s.nb_tube_copies << " (" << s.nb_slice_copies << " slices, "
+                           << s.nb_recycled_tubes << " recycled tubes)" << endl
+        << "Refining iterations: " << s.nb_refining_iterations
+        << " (" << s.nb_refining_samples << " samples)" << endl
+        << "Contractions: " << s.nb_propa_ctc_calls << " (propagation), "
+                            << s.nb_cid_ctc_calls << " (CID)" << endl
+        << "Volume reduction: " << s.propa_volume_reduction << " (propagation), "
+                                << s.cid_volume_reduction << " (CID)" << endl
+        << "Time: " << s.t_total << "s (refining: " << s.t_refining
+        << "s, propagation: " << s.t_propagation
+        << "s, CID: " << s.t_cid
+        << "s, bisection: " << s.t_bisection << "s)";
+    return str;
+  }
+
+  SolverChrono::SolverChrono()
+  {
+    restart();
+  }
+
+  void SolverChrono::restart()
+  {
+    m_t0 = chrono::steady_clock::now();
+  }
+
+  double SolverChrono::elapsed() const
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - m_t0).count();
+  }
+}
@@ -0,0 +1,100 @@
+/** 
+ *  SolverStats class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_SOLVERSTATS_H__
+#define __TUBEX_SOLVERSTATS_H__
+
+#include <iostream>
+#include <string>
+#include <chrono>
+
+namespace tubex
+{
+  class BinaryWriter;
+  class BinaryReader;
+
+  /**
+   * Figures of a resolution, filled in by Solver::solve.
+   * Times are wall-clock durations in seconds. In a parallel search,
+   * the times of the phases are summed over the threads, while
+   * t_total is the duration of the whole resolution.
+   */
+  class SolverStats
+  {
+    public:
+
+      SolverStats();
+      void reset();
+      SolverStats& operator+=(const SolverStats& s);
+
+      // JSON object of the figures, used by the benchmarks
+      const std::string to_json() const;
+      void save_json(const std::string& file_path) const;
+
+      // Binary encoding, used to collect the figures of worker processes
+      void write(BinaryWriter& w) const;
+      void read(BinaryReader& r);
+
+      std::string strategy;     // name of the bisection strategy
+
+      // Search tree
+      int nb_nodes;             // nodes popped from the frontier
+      int nb_bisections;
+      int nb_empty_prunes;      // nodes removed by contractions
+      int max_frontier_size;
+      int nb_clustered;         // nodes merged into others by clustering
+      int nb_solutions;
+      int nb_undecided;         // frontier nodes left by a stopped search
+
+      // Tube copies made by the solver (frontier nodes, CID branches),
+      // and number of slices copied, also into recycled tubes: only
+      // nb_tube_copies - nb_recycled_tubes copies allocated their slices
+      int nb_tube_copies;
+      long nb_slice_copies;
+      int nb_recycled_tubes;    // copies made in released tubes (TubePool)
+
+      // Contractions
+      int nb_refining_iterations;
+      int nb_refining_samples;
+      int nb_propa_ctc_calls;
+      int nb_cid_ctc_calls;
+
+      // Wall-clock times (s)
+      double t_refining;
+      double t_propagation;
+      double t_cid;
+      double t_bisection;
+      double t_total;
+
+      // Volume removed by each phase
+      double propa_volume_reduction;
+      double cid_volume_reduction;
+  };
+
+  std::ostream& operator<<(std::ostream& str, const SolverStats& s);
+
+  /**
+   * Wall-clock chronometer used to fill in SolverStats
+   */
+  class SolverChrono
+  {
+    public:
+
+      SolverChrono();
+      void restart();
+      double elapsed() const; // in seconds since last restart
+
+    protected:
+
+      std::chrono::steady_clock::time_point m_t0;
+  };
+}
+
+#endif
@@ -0,0 +1,116 @@
+/** 
+ *  ThreadPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include "tubex_ThreadPool.h"
+
+using namespace std;
+
+namespace tubex
+{
+  ThreadPool::ThreadPool(int nb_threads)
+  {
+    assert(nb_threads >= 0);
+    for(int k = 0 ; k < nb_threads ; k++)
+      m_threads.push_back(thread(&ThreadPool::loop, this, k));
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_stop = true;
+    }
+
+    m_cv_tasks.notify_all();
+    for(size_t k = 0 ; k < m_threads.size() ; k++)
+      m_threads[k].join();
+  }
+
+  int ThreadPool::nb_threads() const
+  {
+    return m_threads.size();
+  }
+
+  void ThreadPool::run(const vector<function<void()> >& v_tasks)
+  {
+    assert(!v_tasks.empty() && v_tasks.size() <= m_threads.size() + 1);
+
+    {
+      lock_guard<mutex> lock(m_mutex);
+      assert(m_tasks == NULL && "one batch at a time");
+      m_tasks = &v_tasks;
+      m_nb_pending = v_tasks.size() - 1;
+      m_error = nullptr;
+      m_batch++;
+    }
+
+    m_cv_tasks.notify_all();
+
+    exception_ptr error;
+    try
+    {
+      v_tasks[0]();
+    }
+
+    catch(...)
+    {
+      error = current_exception();
+    }
+
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_cv_done.wait(lock, [this] { return m_nb_pending == 0; });
+      m_tasks = NULL;
+      if(!error)
+        error = m_error;
+    }
+
+    if(error)
+      rethrow_exception(error);
+  }
+
+  void ThreadPool::loop(int id)
+  {
+    unsigned int batch = 0;
+    unique_lock<mutex> lock(m_mutex);
+
+    while(true)
+    {
+      m_cv_tasks.wait(lock, [&] { return m_stop || m_batch != batch; });
+      if(m_stop)
+        return;
+
+      batch = m_batch;
+      if(m_tasks == NULL || id + 1 >= (int)m_tasks->size())
+        continue; // batch already done, or without a task for this thread
+
+      const function<void()>& task = (*m_tasks)[id + 1];
+      lock.unlock();
+
+      exception_ptr error;
+      try
+      {
+        task();
+      }
+
+      catch(...)
+      {
+        error = current_exception();
+      }
+
+      lock.lock();
+      if(error && !m_error)
+        m_error = error;
+      if(--m_nb_pending == 0)
+        m_cv_done.notify_one();
+    }
+  }
+}
@@ -0,0 +1,62 @@
+/** 
+ *  ThreadPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_THREADPOOL_H__
+#define __TUBEX_THREADPOOL_H__
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace tubex
+{
+  /**
+   * Threads started once and reused for running small batches of tasks
+   * (such as the CID branches of the Solver), instead of being started
+   * for each batch.
+   *
+   * The first task of a batch is run by the calling thread, the k-th one
+   * by the (k-1)-th thread of the pool: a batch has at most nb_threads+1
+   * tasks. run() returns once all of them are done.
+   */
+  class ThreadPool
+  {
+    public:
+
+      ThreadPool(int nb_threads);
+      ~ThreadPool();
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      int nb_threads() const;
+
+      // Runs the tasks concurrently; the first exception
+      // thrown by a task is rethrown once all are done
+      void run(const std::vector<std::function<void()> >& v_tasks);
+
+    protected:
+
+      void loop(int id);
+
+      std::vector<std::thread> m_threads;
+      std::mutex m_mutex;
+      std::condition_variable m_cv_tasks, m_cv_done;
+      const std::vector<std::function<void()> > *m_tasks = NULL; // during a batch
+      unsigned int m_batch = 0; // id of the last batch
+      int m_nb_pending = 0; // tasks of the threads not done yet
+      std::exception_ptr m_error;
+      bool m_stop = false;
+  };
+}
+
+#endif
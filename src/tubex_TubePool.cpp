@@ -0,0 +1,134 @@
+/** 
+ *  TubePool class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <functional>
+#include "tubex_TubePool.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  TubePool::TubePool(int max_size) : m_max_size(max_size)
+  {
+    assert(max_size >= 0);
+  }
+
+  TubePool::~TubePool()
+  {
+    for(Released::iterator it = m_tubes.begin() ; it != m_tubes.end() ; ++it)
+      delete it->second;
+  }
+
+  TubeVector* TubePool::copy(const TubeVector& x)
+  {
+    size_t key = slicing_key(x);
+    unordered_map<size_t,vector<Released::iterator> >::iterator bucket = m_buckets.find(key);
+
+    // The last released tube of the bucket: a different slicing
+    // of the same key is unlikely, x is then allocated
+    if(bucket != m_buckets.end())
+    {
+      Released::iterator it = bucket->second.back();
+      TubeVector *y = it->second;
+      if(overwrite(*y, x))
+      {
+        bucket->second.pop_back();
+        if(bucket->second.empty())
+          m_buckets.erase(bucket);
+        m_tubes.erase(it);
+        m_nb_recycled++;
+        return y;
+      }
+    }
+
+    return new TubeVector(x);
+  }
+
+  void TubePool::release(TubeVector *x)
+  {
+    if(x == NULL)
+      return;
+
+    if(m_max_size == 0)
+    {
+      delete x;
+      return;
+    }
+
+    // When the pool is full, the oldest tube is deleted (first of its bucket)
+    if((int)m_tubes.size() >= m_max_size)
+    {
+      unordered_map<size_t,vector<Released::iterator> >::iterator bucket = m_buckets.find(m_tubes.front().first);
+      assert(bucket != m_buckets.end() && bucket->second.front() == m_tubes.begin());
+      bucket->second.erase(bucket->second.begin());
+      if(bucket->second.empty())
+        m_buckets.erase(bucket);
+      delete m_tubes.front().second;
+      m_tubes.pop_front();
+    }
+
+    size_t key = slicing_key(*x);
+    m_tubes.push_back(make_pair(key, x));
+    m_buckets[key].push_back(--m_tubes.end());
+  }
+
+  int TubePool::nb_recycled() const
+  {
+    return m_nb_recycled;
+  }
+
+  size_t TubePool::slicing_key(const TubeVector& x)
+  {
+    // Combination of the hashes of the dimension, the lower bounds
+    // of the slices and the number of slices of each component
+    hash<double> h;
+    size_t key = x.size();
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      size_t nb_slices = 0;
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice(), nb_slices++)
+        key ^= h(s->domain().lb()) + 0x9e3779b9 + (key << 6) + (key >> 2);
+      key ^= nb_slices + 0x9e3779b9 + (key << 6) + (key >> 2);
+    }
+    return key;
+  }
+
+  bool TubePool::overwrite(TubeVector& y, const TubeVector& x)
+  {
+    if(y.size() != x.size())
+      return false;
+
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      const Slice *s_x = x[i].first_slice(), *s_y = y[i].first_slice();
+      for( ; s_y != NULL && s_x != NULL ; s_y = s_y->next_slice(), s_x = s_x->next_slice())
+        if(s_y->domain() != s_x->domain())
+          return false;
+      if(s_y != NULL || s_x != NULL) // different numbers of slices
+        return false;
+    }
+
+    // Same slicing: values are copied slice by slice, without
+    // consistency checks (x is already consistent)
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      const Slice *s_x = x[i].first_slice();
+      for(Slice *s_y = y[i].first_slice() ; s_y != NULL ; s_y = s_y->next_slice(), s_x = s_x->next_slice())
+      {
+        s_y->set_envelope(s_x->codomain(), false);
+        s_y->set_input_gate(s_x->input_gate(), false);
+      }
+      y[i].last_slice()->set_output_gate(x[i].last_slice()->output_gate(), false);
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,61 @@
+/** 
+ *  TubePool class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TUBEPOOL_H__
+#define __TUBEX_TUBEPOOL_H__
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * Tubes released by the Solver once a node is processed (CID branches,
+   * pruned nodes...), kept to be recycled by the next copies.
+   *
+   * A copy of x recycles a released tube of the same slicing: its slices
+   * are overwritten in place, without any allocation. Released tubes are
+   * bucketed by a key of their slicing (number and bounds of the slices),
+   * so that a copy only compares x with a tube of the same key. The
+   * oldest released tubes are deleted when the pool is full.
+   * Note: a pool is not thread-safe, each thread of the Solver owns one
+   */
+  class TubePool
+  {
+    public:
+
+      TubePool(int max_size = 16);
+      ~TubePool();
+      TubePool(const TubePool&) = delete;
+      TubePool& operator=(const TubePool&) = delete;
+
+      // Copy of x, to be given back with release() (or deleted)
+      TubeVector* copy(const TubeVector& x);
+      void release(TubeVector *x);
+
+      int nb_recycled() const; // copies made without allocation
+
+    protected:
+
+      typedef std::list<std::pair<size_t,TubeVector*> > Released;
+
+      static size_t slicing_key(const TubeVector& x);
+      static bool overwrite(TubeVector& y, const TubeVector& x);
+
+      int m_max_size;
+      int m_nb_recycled = 0;
+      Released m_tubes; // released tubes with their key, last released at the back
+      std::unordered_map<size_t,std::vector<Released::iterator> > m_buckets; // same order
+  };
+}
+
+#endif
@@ -0,0 +1,82 @@
+/** 
+ *  TubeSignature class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "tubex_TubeSignature.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  TubeSignature::TubeSignature(const TubeVector& x, int nb_chunks)
+    : m_chunks(nb_chunks, IntervalVector(x.size(), Interval::EMPTY_SET))
+  {
+    assert(nb_chunks > 0);
+
+    double t0 = x.domain().lb(), chunk_length = x.domain().diam() / nb_chunks;
+    for(int i = 0 ; i < x.size() ; i++)
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        // Chunks whose interior meets the slice; a slice bound close to
+        // a chunk bound also adds the neighbouring chunk (rounding errors)
+        int j_lb = (int)std::floor((s->domain().lb() - t0) / chunk_length - 1e-9);
+        int j_ub = (int)std::ceil((s->domain().ub() - t0) / chunk_length + 1e-9) - 1;
+        j_lb = std::max(0, std::min(nb_chunks - 1, j_lb));
+        j_ub = std::max(j_lb, std::min(nb_chunks - 1, j_ub));
+        for(int j = j_lb ; j <= j_ub ; j++)
+          m_chunks[j][i] |= s->codomain();
+      }
+  }
+
+  int TubeSignature::nb_chunks() const
+  {
+    return m_chunks.size();
+  }
+
+  const IntervalVector& TubeSignature::chunk(int j) const
+  {
+    assert(j >= 0 && j < nb_chunks());
+    return m_chunks[j];
+  }
+
+  TubeSignature& TubeSignature::operator|=(const TubeSignature& x)
+  {
+    assert(x.nb_chunks() == nb_chunks());
+    for(int j = 0 ; j < nb_chunks() ; j++)
+      m_chunks[j] |= x.m_chunks[j];
+    return *this;
+  }
+
+  bool TubeSignature::may_overlap(const TubeSignature& x, float ratio) const
+  {
+    assert(x.nb_chunks() == nb_chunks());
+
+    int nb_required = nb_required_chunks(nb_chunks(), ratio);
+    for(int i = 0 ; i < m_chunks[0].size() ; i++)
+    {
+      int nb_intersecting = 0;
+      for(int j = 0 ; j < nb_chunks() ; j++)
+        nb_intersecting += m_chunks[j][i].intersects(x.m_chunks[j][i]);
+      if(nb_intersecting < nb_required)
+        return false;
+    }
+
+    return true;
+  }
+
+  int TubeSignature::nb_required_chunks(int nb_chunks, float ratio)
+  {
+    // Rounded down: the bound must hold despite rounding errors,
+    // and at least one chunk meets a non-null overlap
+    return ratio == 0. ? 0 : std::max(1, (int)std::floor(ratio * nb_chunks));
+  }
+}
@@ -0,0 +1,55 @@
+/** 
+ *  TubeSignature class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TUBESIGNATURE_H__
+#define __TUBEX_TUBESIGNATURE_H__
+
+#include <vector>
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * Envelopes of the components of a tube over nb_chunks time chunks
+   * of equal length, used by the Solver to select the candidates of
+   * the clustering without comparing whole tubes.
+   *
+   * Two tubes overlapping over a ratio r of their domain (see
+   * TubeVector::overlaps) have intersecting envelopes in at least
+   * r*nb_chunks chunks of each component: the overlapping slices
+   * cover r times the domain, and each chunk covers 1/nb_chunks of it.
+   */
+  class TubeSignature
+  {
+    public:
+
+      TubeSignature(const TubeVector& x, int nb_chunks);
+
+      int nb_chunks() const;
+      // Envelopes of the components of the tube over the chunk j
+      const ibex::IntervalVector& chunk(int j) const;
+
+      // Signature of the union of the tubes (possibly wider)
+      TubeSignature& operator|=(const TubeSignature& x);
+
+      // False if the tubes cannot overlap over the ratio
+      // (see TubeVector::overlaps), true if they may
+      bool may_overlap(const TubeSignature& x, float ratio) const;
+      // Number of chunks of the first component intersecting
+      // in two tubes overlapping over the ratio
+      static int nb_required_chunks(int nb_chunks, float ratio);
+
+    protected:
+
+      std::vector<ibex::IntervalVector> m_chunks;
+  };
+}
+
+#endif
@@ -0,0 +1,208 @@
+/** 
+ *  TubeSummary class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "tubex_TubeSummary.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  TubeSummary::TubeSummary()
+  {
+
+  }
+
+  void TubeSummary::reset(const TubeVector& x)
+  {
+    m_domain = x.domain();
+    m_slices.resize(x.size());
+    m_output_gates.resize(x.size());
+    m_max_diam = Vector(x.size(), 0.);
+    m_volume = 0.;
+    m_nb_unbounded = 0;
+    m_nb_empty = 0;
+
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      m_slices[i].clear();
+      for(const Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        m_slices[i].push_back(SliceValue());
+        SliceValue& v = m_slices[i].back();
+        slice_value(*s, v);
+        add_volume(v.volume, 1);
+        m_max_diam[i] = std::max(m_max_diam[i], v.diam);
+        m_nb_empty += v.input_gate.is_empty() + v.codomain.is_empty();
+      }
+
+      m_output_gates[i] = x[i].last_slice()->output_gate();
+      m_nb_empty += m_output_gates[i].is_empty();
+    }
+  }
+
+  const Interval TubeSummary::update(const TubeVector& x)
+  {
+    return update(x, x.domain());
+  }
+
+  const Interval TubeSummary::update(const TubeVector& x, const Interval& t_modified)
+  {
+    if((int)m_slices.size() != x.size() || x.domain() != m_domain)
+    {
+      reset(x);
+      return x.domain();
+    }
+
+    if(t_modified.is_empty())
+      return Interval::EMPTY_SET;
+    assert(t_modified.is_subset(m_domain));
+
+    Interval t_window = Interval::EMPTY_SET;
+    for(int i = 0 ; i < x.size() ; i++)
+    {
+      // Contractions only decrease the diameters: the max is computed
+      // again only if the slice that reached it has been contracted
+      bool max_diam_lost = false;
+
+      // Over the whole domain, the slices are taken from x, as its slicing
+      // may have changed anywhere; otherwise, the scan starts from the
+      // cached slice of t_modified.lb(), unchanged before it
+      size_t k = 0;
+      const Slice *s = x[i].first_slice();
+      if(t_modified.lb() > m_domain.lb())
+      {
+        k = slice_index(i, t_modified.lb());
+        s = m_slices[i][k].slice;
+      }
+
+      for( ; s != NULL && s->domain().lb() <= t_modified.ub() ; s = s->next_slice(), k++)
+      {
+        if(k == m_slices[i].size() || s->domain() != m_slices[i][k].domain)
+        {
+          reset(x); // slicing changed by the contraction
+          return x.domain();
+        }
+
+        SliceValue& v = m_slices[i][k];
+        if(s->input_gate() == v.input_gate && s->codomain() == v.codomain)
+          continue;
+
+        if(s->input_gate() != v.input_gate)
+          t_window |= s->domain().lb();
+        if(s->codomain() != v.codomain)
+          t_window |= s->domain();
+
+        double prev_diam = v.diam;
+        add_volume(v.volume, -1);
+        m_nb_empty -= v.input_gate.is_empty() + v.codomain.is_empty();
+        slice_value(*s, v);
+        add_volume(v.volume, 1);
+        m_nb_empty += v.input_gate.is_empty() + v.codomain.is_empty();
+
+        if(v.diam >= m_max_diam[i])
+          m_max_diam[i] = v.diam;
+        else if(prev_diam == m_max_diam[i])
+          max_diam_lost = true;
+      }
+
+      if(s == NULL && k != m_slices[i].size())
+      {
+        reset(x); // slices removed
+        return x.domain();
+      }
+
+      if(t_modified.ub() == m_domain.ub())
+      {
+        const Interval output_gate = m_slices[i].back().slice->output_gate();
+        if(output_gate != m_output_gates[i])
+        {
+          t_window |= m_domain.ub();
+          m_nb_empty += output_gate.is_empty() - m_output_gates[i].is_empty();
+          m_output_gates[i] = output_gate;
+        }
+      }
+
+      if(max_diam_lost)
+        update_max_diam(i);
+    }
+
+    if(t_window.is_empty())
+      return t_window;
+
+    // The window is inflated by one slice on each side,
+    // where the contractions may spread at the next pass
+    const vector<SliceValue>& v_slices = m_slices[0];
+    size_t k_lb = slice_index(0, t_window.lb()), k_ub = slice_index(0, t_window.ub());
+    if(k_lb > 0) k_lb--;
+    if(k_ub + 1 < v_slices.size()) k_ub++;
+    return v_slices[k_lb].domain | v_slices[k_ub].domain;
+  }
+
+  double TubeSummary::volume() const
+  {
+    return m_nb_unbounded > 0 ? POS_INFINITY : m_volume;
+  }
+
+  const Vector& TubeSummary::max_diam() const
+  {
+    return m_max_diam;
+  }
+
+  bool TubeSummary::is_empty() const
+  {
+    return m_nb_empty > 0;
+  }
+
+  void TubeSummary::slice_value(const Slice& s, SliceValue& v)
+  {
+    v.slice = &s;
+    v.domain = s.domain();
+    v.input_gate = s.input_gate();
+    v.codomain = s.codomain();
+    v.volume = s.is_empty() ? 0. : s.volume();
+    v.diam = v.codomain.is_empty() ? 0. : v.codomain.diam();
+  }
+
+  void TubeSummary::add_volume(double volume, int sign)
+  {
+    // Infinite contributions are counted apart: oo-oo would give NaN
+    if(std::isinf(volume))
+      m_nb_unbounded += sign;
+    else
+      m_volume += sign * volume;
+  }
+
+  void TubeSummary::update_max_diam(int i)
+  {
+    m_max_diam[i] = 0.;
+    for(size_t k = 0 ; k < m_slices[i].size() ; k++)
+      m_max_diam[i] = std::max(m_max_diam[i], m_slices[i][k].diam);
+  }
+
+  size_t TubeSummary::slice_index(int i, double t) const
+  {
+    // Binary search on the cached slices: walking the
+    // slices of x would be linear in their number
+    const vector<SliceValue>& v_slices = m_slices[i];
+    size_t lb = 0, ub = v_slices.size() - 1;
+    while(lb < ub)
+    {
+      size_t mid = (lb + ub) / 2;
+      if(v_slices[mid].domain.ub() < t)
+        lb = mid + 1;
+      else
+        ub = mid;
+    }
+    return lb;
+  }
+}
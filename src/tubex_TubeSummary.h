@@ -0,0 +1,78 @@
+/** 
+ *  TubeSummary class
+ * ----------------------------------------------------------------------------
+ *  \date       2019
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2019 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TUBESUMMARY_H__
+#define __TUBEX_TUBESUMMARY_H__
+
+#include <vector>
+#include "tubex_TubeVector.h"
+
+namespace tubex
+{
+  /**
+   * Figures of a tube used by the fixed-point and stopping checks of the
+   * Solver: volume, max diameter of each component, emptiness.
+   *
+   * The values of the slices are cached, so that an update after a
+   * contraction only recomputes the contributions of the slices that
+   * changed, and returns the time window of these changes. When the
+   * contractor tells where it may have contracted the tube (see
+   * SolverContractor::contract_window), only the slices of this region
+   * are scanned.
+   */
+  class TubeSummary
+  {
+    public:
+
+      TubeSummary();
+
+      // Full computation of the figures of x
+      void reset(const TubeVector& x);
+
+      // Figures of x after a contraction. Returns the time window of the
+      // modified slices and gates, inflated by one slice on each side
+      // (empty if x did not change, x.domain() if its slicing did)
+      const ibex::Interval update(const TubeVector& x);
+
+      // Same, x being unchanged outside t_modified (slices and gates):
+      // only the slices intersecting t_modified are scanned. In this
+      // region, the slicing may only have changed by sampling
+      const ibex::Interval update(const TubeVector& x, const ibex::Interval& t_modified);
+
+      double volume() const; // as TubeVector::volume()
+      const ibex::Vector& max_diam() const; // as TubeVector::max_diam()
+      bool is_empty() const;
+
+    protected:
+
+      struct SliceValue
+      {
+        const Slice *slice; // valid as long as the slicing is the same
+        ibex::Interval domain, input_gate, codomain;
+        double volume, diam;
+      };
+
+      static void slice_value(const Slice& s, SliceValue& v);
+      void add_volume(double volume, int sign);
+      void update_max_diam(int i);
+      // Index of the first slice of the component i that contains t
+      size_t slice_index(int i, double t) const;
+
+      ibex::Interval m_domain;
+      std::vector<std::vector<SliceValue> > m_slices; // for each component
+      std::vector<ibex::Interval> m_output_gates; // final gate of each component
+      double m_volume = 0.; // sum of the finite slice volumes
+      int m_nb_unbounded = 0; // number of slices of infinite volume
+      ibex::Vector m_max_diam = ibex::Vector(1);
+      int m_nb_empty = 0; // number of empty slices and gates
+  };
+}
+
+#endif